@@ -0,0 +1,77 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      ConcurrentBus
+*  Description:  Update two extension controllers at the same time, each on
+*                their own I2C bus (Wire and Wire1). The transfers run in the
+*                background, so both buses are busy at once. Requires a
+*                Teensy 3.x or LC, which use the i2c_t3 library.
+*
+*                This example uses Nunchuks, but this process works the same
+*                with any controller in the library.
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+Nunchuk nchuk1(Wire);   // Controller on bus #1
+Nunchuk nchuk2(Wire1);  // Controller on bus #2
+
+// Background updates for both controllers
+NintendoExtensionCtrl::SplitUpdate<i2c_t3> updates[] = { nchuk1, nchuk2 };
+
+void setup() {
+	Serial.begin(115200);
+
+	while (!Serial);  // Wait for serial for debug
+	Serial.println("Attempting connection to controllers...");
+
+	nchuk1.begin();
+	while (!nchuk1.connect()) {
+		Serial.println("Nunchuk on bus #1 not detected!");
+		delay(1000);
+	}
+
+	nchuk2.begin();
+	while (!nchuk2.connect()) {
+		Serial.println("Nunchuk on bus #2 not detected!");
+		delay(1000);
+	}
+}
+
+void loop() {
+	Serial.println("-------------");
+
+	NintendoExtensionCtrl::updateAll(updates);  // Update both at once
+
+	if (updates[0].succeeded()) {
+		nchuk1.printDebug();
+	}
+	else {
+		Serial.println("Bus #1 Disconnected");
+	}
+
+	if (updates[1].succeeded()) {
+		nchuk2.printDebug();
+	}
+	else {
+		Serial.println("Bus #2 Disconnected");
+	}
+}
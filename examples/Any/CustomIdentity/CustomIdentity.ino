@@ -0,0 +1,73 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      CustomIdentity
+*  Description:  Teach the library a controller it doesn't know, the Taiko
+*                no Tatsujin drum, by adding it to the identity registry.
+*                The drum connects as its own type and its raw data is
+*                printed to the serial monitor.
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+const ExtensionType TaikoDrum = (ExtensionType) 0x40;  // Any value past the library's types
+
+// Runs when the drum connects. Return 'false' to fail the connection.
+boolean setupTaiko(ExtensionController & port) {
+	Serial.println("Taiko drum connected!");
+	return true;
+}
+
+// ID bytes, the bits of them that have to match, type, request size, setup
+const NintendoExtensionCtrl::IdentityEntry MyControllers[] = {
+	{ { 0x00, 0x00, 0xA4, 0x20, 0x01, 0x11 }, { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }, TaikoDrum, 6, setupTaiko },
+};
+NXC_USER_IDENTITIES(MyControllers)
+
+ExtensionPort port;
+
+void setup() {
+	Serial.begin(115200);
+	port.begin();
+
+	while (!port.connect()) {
+		Serial.println("No controller found!");
+		delay(1000);
+	}
+
+	if (port.getControllerType() != TaikoDrum) {
+		Serial.println("Not a Taiko drum, printing its data anyway");
+	}
+}
+
+void loop() {
+	boolean success = port.update();  // Get new data from the controller
+
+	if (success == true) {  // We've got data!
+		port.printDebugRaw(BIN);  // Drum hits are bits in byte 5
+		delay(100);
+	}
+	else {  // Data is bad :(
+		Serial.println("Controller Disconnected!");
+		delay(1000);
+		port.connect();
+	}
+}
@@ -0,0 +1,57 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      DebugQueue
+*  Description:  Connect to an extension controller and print its debug
+*                output without ever waiting on the serial port. Lines go
+*                into a queue that's drained as the UART has room, and
+*                lines that don't fit are dropped instead of slowing the
+*                polling loop down.
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+ExtensionPort controller;
+NintendoExtensionCtrl::DebugQueueBuffer<256> debugQueue;  // Whole lines, up to 256 bytes
+
+void setup() {
+	Serial.begin(115200);
+	controller.begin();
+
+	while (!controller.connect()) {
+		Serial.println("Controller not detected!");
+		delay(1000);
+	}
+}
+
+void loop() {
+	boolean success = controller.update();  // Get new data from the controller
+
+	if (success == true) {  // We've got data!
+		controller.printDebug(debugQueue);  // Queued, doesn't wait on the UART
+	}
+	else {  // Data is bad :(
+		debugQueue.println("Controller Disconnected!");
+		controller.reconnect();
+	}
+
+	debugQueue.drain(Serial);  // Send what fits in the serial buffer right now
+}
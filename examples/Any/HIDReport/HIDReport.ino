@@ -0,0 +1,66 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      HIDReport
+*  Description:  Connect to any supported controller and pack its data into
+*                a USB HID gamepad report, printing the report whenever it
+*                changes. Pass the report and 'HIDGamepadDescriptor' to your
+*                board's USB HID library to show up as a gamepad.
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+ExtensionPort controller;
+NintendoExtensionCtrl::ButtonRemap remap;  // Default gamepad layout for the buttons
+NintendoExtensionCtrl::HIDReportBuilder hid(remap);
+
+void setup() {
+	Serial.begin(115200);
+	controller.begin();
+
+	while (!controller.connect()) {
+		Serial.println("No controller detected!");
+		delay(1000);
+	}
+}
+
+void loop() {
+	boolean success = controller.update();  // Get new data from the controller
+
+	if (!success) {  // Ruh roh
+		Serial.println("Controller disconnected!");
+		delay(1000);
+		controller.connect();
+		return;
+	}
+
+	if (hid.build(controller)) {  // Only print on changes
+		const uint8_t * report = hid.getReport();
+
+		Serial.print("Report:");
+		for (uint8_t i = 0; i < NintendoExtensionCtrl::HIDReportBuilder::ReportSize; i++) {
+			Serial.print(' ');
+			if (report[i] < 0x10) Serial.print('0');
+			Serial.print(report[i], HEX);
+		}
+		Serial.println();
+	}
+}
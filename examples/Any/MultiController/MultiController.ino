@@ -0,0 +1,63 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      MultiController
+*  Description:  Connect to a Nunchuk, NES Mini, or Guitar Hero guitar using
+*                one port, and print its debug output. The port picks the
+*                right decoder, request size, and knockoff fix when the
+*                controller connects.
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+NintendoExtensionCtrl::MultiController<Nunchuk, NESMiniController, GuitarController> controller;
+
+// Called with the connected controller's 'Shared' class
+struct PrintDebug {
+	template<class Controller>
+	void operator()(Controller & c) const {
+		c.printDebug();
+	}
+};
+
+void setup() {
+	Serial.begin(115200);
+	controller.begin();
+
+	while (!controller.connect()) {
+		Serial.println("No supported controller found!");
+		delay(1000);
+	}
+}
+
+void loop() {
+	boolean success = controller.update();  // Get new data from the controller
+
+	if (success == true) {  // We've got data!
+		controller.visit(PrintDebug());
+		delay(100);
+	}
+	else {  // Data is bad :(
+		Serial.println("Controller Disconnected!");
+		delay(1000);
+		controller.connect();
+	}
+}
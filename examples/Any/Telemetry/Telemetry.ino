@@ -0,0 +1,53 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      Telemetry
+*  Description:  Connect to any supported controller and stream its raw data
+*                as binary telemetry, at the full update rate. Only the
+*                bytes that change are sent. Decode the output on a PC with
+*                the host tools in 'extras/host' ('nxc_telemetry decode').
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+ExtensionPort controller;
+NintendoExtensionCtrl::TelemetryStreamTable<1> telemetry(Serial);  // One port, over Serial
+
+void setup() {
+	Serial.begin(115200);
+	controller.begin();
+
+	while (!controller.connect()) {
+		delay(1000);  // No text output, it would corrupt the stream
+	}
+}
+
+void loop() {
+	boolean success = controller.update();  // Get new data from the controller
+
+	if (!success) {  // Ruh roh
+		delay(1000);
+		controller.connect();
+		return;
+	}
+
+	telemetry.send(0, controller);  // Port 0
+}
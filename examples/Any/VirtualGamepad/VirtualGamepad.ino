@@ -0,0 +1,69 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      VirtualGamepad
+*  Description:  Connect to any supported controller and read its buttons
+*                as one common gamepad layout, using lookup tables built
+*                from a remap profile.
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+using NintendoExtensionCtrl::VirtualGamepad;
+
+ExtensionPort controller;
+NintendoExtensionCtrl::ButtonRemap gamepad;  // Uses the default profile
+
+uint16_t lastButtons = 0;
+
+void setup() {
+	Serial.begin(115200);
+	controller.begin();
+
+	while (!controller.connect()) {
+		Serial.println("No controller detected!");
+		delay(1000);
+	}
+}
+
+void loop() {
+	boolean success = controller.update();  // Get new data from the controller
+
+	if (!success) {  // Ruh roh
+		Serial.println("Controller disconnected!");
+		delay(1000);
+		controller.connect();
+		return;
+	}
+
+	uint16_t buttons = gamepad.map(controller);  // Tables are rebuilt if the type changes
+
+	if (buttons != lastButtons) {  // Only print on changes
+		Serial.print("Gamepad: ");
+		Serial.print(buttons & VirtualGamepad::A ? 'A' : '_');
+		Serial.print(buttons & VirtualGamepad::B ? 'B' : '_');
+		Serial.print(buttons & VirtualGamepad::X ? 'X' : '_');
+		Serial.print(buttons & VirtualGamepad::Y ? 'Y' : '_');
+		Serial.print(" | Raw 0x");
+		Serial.println(buttons, HEX);
+		lastButtons = buttons;
+	}
+}
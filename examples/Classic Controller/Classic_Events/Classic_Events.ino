@@ -0,0 +1,75 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      Classic_Events
+*  Description:  Connect to a Classic Controller and register callbacks
+*                that only run when their controls change, instead of
+*                polling every button each loop.
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+ClassicController classic;
+NintendoExtensionCtrl::ControlEventTable<4> events;  // Room for 4 callbacks
+
+void pressA() {
+	Serial.println("A pressed");
+}
+
+void releaseA() {
+	Serial.println("A released");
+}
+
+void pressHome() {
+	Serial.println("Home pressed");
+}
+
+void moveLeftX(uint16_t x) {
+	Serial.print("Left joystick X: ");
+	Serial.println(x);
+}
+
+void setup() {
+	Serial.begin(115200);
+	classic.begin();
+
+	events.onPress(ClassicController::Maps::ButtonA, pressA);
+	events.onRelease(ClassicController::Maps::ButtonA, releaseA);
+	events.onPress(ClassicController::Maps::ButtonHome, pressHome);
+	events.onAxisChange(ClassicController::Maps::LeftJoyX, 2, moveLeftX);  // Ignore changes < 2
+
+	classic.attachEvents(events);  // Callbacks now run from update()
+
+	while (!classic.connect()) {
+		Serial.println("Classic Controller not detected!");
+		delay(1000);
+	}
+}
+
+void loop() {
+	boolean success = classic.update();  // Get new data, and run any callbacks
+
+	if (!success) {  // Ruh roh
+		Serial.println("Controller disconnected!");
+		delay(1000);
+		classic.connect();
+	}
+}
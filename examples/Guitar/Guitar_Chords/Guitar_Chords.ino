@@ -0,0 +1,74 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*  Example:      Guitar_Chords
+*  Description:  Connect to a Guitar Hero controller and use the input
+*                engine to read strums and look up chords from the
+*                fret buttons and touchbar.
+*/
+
+#include <NintendoExtensionCtrl.h>
+
+GuitarController guitar;
+GuitarController::InputEngine engine(guitar);  // Pass the object to the input engine
+
+// Chord names, indexed by the packed fret mask (Green = bit 0 ... Orange = bit 4)
+enum Chord : uint8_t { NoChord, Power, Minor, Major, Single };
+
+const uint8_t chords[32] = {
+	NoChord, Single, Single, Power,  Single, Minor,  Power,  Major,  // 0b00000 - 0b00111
+	Single,  Power,  Minor,  Major,  Power,  Major,  Major,  Major,  // 0b01000 - 0b01111
+	Single,  Minor,  Power,  Major,  Minor,  Major,  Major,  Major,  // 0b10000 - 0b10111
+	Power,   Major,  Major,  Major,  Major,  Major,  Major,  Major,  // 0b11000 - 0b11111
+};
+
+const char * const ChordNames[] = { "-", "Power", "Minor", "Major", "Single" };
+
+void setup() {
+	Serial.begin(115200);
+	guitar.begin();
+
+	while (!guitar.connect()) {
+		Serial.println("Guitar controller not detected!");
+		delay(1000);
+	}
+
+	engine.setChordTable(chords);
+	engine.setDebounce(3);  // Ignore strum bar bounce for 3 frames after a strum
+}
+
+void loop() {
+	boolean success = guitar.update();  // Get new data from the controller
+
+	if (!success) {  // Ruh roh
+		Serial.println("Controller disconnected!");
+		delay(1000);
+		return;
+	}
+
+	const GuitarController::InputEngine::Frame & frame = engine.process();
+
+	if (frame.strum != 0) {  // Only print when the strum bar is hit
+		Serial.print(frame.strum & GuitarController::Strum::Up ? "Up   " : "Down ");
+		Serial.print("strum, chord: ");
+		Serial.println(ChordNames[frame.chord]);
+	}
+}
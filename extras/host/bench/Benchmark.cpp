@@ -0,0 +1,284 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Decode and transport benchmarks for the library, run against the simulated
+// bus. Usage: nxc_bench [--csv] [--filter text] [--min-time ms]
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_Bench.h"
+#include "NXC_SimController.h"
+
+using namespace NXC_Bench;
+using NXC_Host::SimulatedController;
+
+#define BENCH_GET(group, obj, fn) \
+	runner.run(group, #fn, [&]() { sink += (uint32_t) obj.fn(); })
+
+static SimulatedController sim;
+static NullPrint nullOutput;
+
+template<class Controller>
+static void connectAs(Controller & controller, ExtensionType type) {
+	sim.setType(type);
+	sim.reset();
+	controller.begin();
+
+	if (!controller.connect()) {
+		fprintf(stderr, "Could not connect to simulated controller (type %d)\n", (int) type);
+		exit(1);
+	}
+}
+
+static void benchNunchuk(Runner & runner) {
+	Nunchuk nchuk;
+	connectAs(nchuk, ExtensionType::Nunchuk);
+
+	const char * g = "nunchuk";
+	BENCH_GET(g, nchuk, joyX);
+	BENCH_GET(g, nchuk, joyY);
+	BENCH_GET(g, nchuk, accelX);
+	BENCH_GET(g, nchuk, accelY);
+	BENCH_GET(g, nchuk, accelZ);
+	BENCH_GET(g, nchuk, buttonC);
+	BENCH_GET(g, nchuk, buttonZ);
+	BENCH_GET(g, nchuk, rollAngle);
+	BENCH_GET(g, nchuk, pitchAngle);
+	runner.run(g, "readAll", [&]() {
+		clobber();
+		sink += nchuk.joyX() + nchuk.joyY() + nchuk.accelX() + nchuk.accelY() + nchuk.accelZ() +
+			nchuk.buttonC() + nchuk.buttonZ();
+	});
+	runner.run(g, "printDebug", [&]() { nchuk.printDebug(nullOutput); });
+}
+
+static void benchClassic(Runner & runner) {
+	ClassicController classic;
+	connectAs(classic, ExtensionType::ClassicController);
+
+	const char * g = "classic";
+	BENCH_GET(g, classic, leftJoyX);
+	BENCH_GET(g, classic, leftJoyY);
+	BENCH_GET(g, classic, rightJoyX);
+	BENCH_GET(g, classic, rightJoyY);
+	BENCH_GET(g, classic, dpadUp);
+	BENCH_GET(g, classic, dpadDown);
+	BENCH_GET(g, classic, dpadLeft);
+	BENCH_GET(g, classic, dpadRight);
+	BENCH_GET(g, classic, buttonA);
+	BENCH_GET(g, classic, buttonB);
+	BENCH_GET(g, classic, buttonX);
+	BENCH_GET(g, classic, buttonY);
+	BENCH_GET(g, classic, triggerL);
+	BENCH_GET(g, classic, triggerR);
+	BENCH_GET(g, classic, buttonL);
+	BENCH_GET(g, classic, buttonR);
+	BENCH_GET(g, classic, buttonZL);
+	BENCH_GET(g, classic, buttonZR);
+	BENCH_GET(g, classic, buttonStart);
+	BENCH_GET(g, classic, buttonSelect);
+	BENCH_GET(g, classic, buttonPlus);
+	BENCH_GET(g, classic, buttonMinus);
+	BENCH_GET(g, classic, buttonHome);
+	BENCH_GET(g, classic, isNESKnockoff);
+	runner.run(g, "readAll", [&]() {
+		clobber();
+		sink += classic.leftJoyX() + classic.leftJoyY() + classic.rightJoyX() + classic.rightJoyY() +
+			classic.triggerL() + classic.triggerR() +
+			classic.dpadUp() + classic.dpadDown() + classic.dpadLeft() + classic.dpadRight() +
+			classic.buttonA() + classic.buttonB() + classic.buttonX() + classic.buttonY() +
+			classic.buttonL() + classic.buttonR() + classic.buttonZL() + classic.buttonZR() +
+			classic.buttonPlus() + classic.buttonMinus() + classic.buttonHome();
+	});
+	runner.run(g, "printDebug", [&]() { classic.printDebug(nullOutput); });
+
+	NintendoExtensionCtrl::DebugQueueBuffer<256> queue;
+	runner.run(g, "printDebug[queue]", [&]() {
+		classic.printDebug(queue);
+		queue.drain(nullOutput);
+	});
+
+	NESMiniController::Shared nes(classic.getExtensionData());
+	runner.run("nes", "printDebug", [&]() { nes.printDebug(nullOutput); });
+
+	SNESMiniController::Shared snes(classic.getExtensionData());
+	runner.run("snes", "printDebug", [&]() { snes.printDebug(nullOutput); });
+}
+
+static void benchGuitar(Runner & runner) {
+	GuitarController guitar;
+	connectAs(guitar, ExtensionType::GuitarController);
+
+	const char * g = "guitar";
+	BENCH_GET(g, guitar, joyX);
+	BENCH_GET(g, guitar, joyY);
+	BENCH_GET(g, guitar, strum);
+	BENCH_GET(g, guitar, strumUp);
+	BENCH_GET(g, guitar, strumDown);
+	BENCH_GET(g, guitar, strumMask);
+	BENCH_GET(g, guitar, fretGreen);
+	BENCH_GET(g, guitar, fretRed);
+	BENCH_GET(g, guitar, fretYellow);
+	BENCH_GET(g, guitar, fretBlue);
+	BENCH_GET(g, guitar, fretOrange);
+	BENCH_GET(g, guitar, fretMask);
+	BENCH_GET(g, guitar, whammyBar);
+	BENCH_GET(g, guitar, touchbar);
+	BENCH_GET(g, guitar, touchGreen);
+	BENCH_GET(g, guitar, touchRed);
+	BENCH_GET(g, guitar, touchYellow);
+	BENCH_GET(g, guitar, touchBlue);
+	BENCH_GET(g, guitar, touchOrange);
+	BENCH_GET(g, guitar, touchMask);
+	BENCH_GET(g, guitar, buttonPlus);
+	BENCH_GET(g, guitar, buttonMinus);
+	runner.run(g, "readAll", [&]() {
+		clobber();
+		sink += guitar.joyX() + guitar.joyY() + guitar.strumMask() + guitar.fretMask() +
+			guitar.whammyBar() + guitar.touchbar() + guitar.buttonPlus() + guitar.buttonMinus();
+	});
+	runner.run(g, "printDebug", [&]() { guitar.printDebug(nullOutput); });
+
+	GuitarController::InputEngine engine(guitar);
+	runner.run(g, "InputEngine::process", [&]() { sink += engine.process().chord; });
+}
+
+static void benchDrums(Runner & runner) {
+	DrumController drums;
+	connectAs(drums, ExtensionType::DrumController);
+
+	const char * g = "drums";
+	BENCH_GET(g, drums, joyX);
+	BENCH_GET(g, drums, joyY);
+	BENCH_GET(g, drums, drumRed);
+	BENCH_GET(g, drums, drumBlue);
+	BENCH_GET(g, drums, drumGreen);
+	BENCH_GET(g, drums, cymbalYellow);
+	BENCH_GET(g, drums, cymbalOrange);
+	BENCH_GET(g, drums, bassPedal);
+	BENCH_GET(g, drums, buttonPlus);
+	BENCH_GET(g, drums, buttonMinus);
+	BENCH_GET(g, drums, velocityAvailable);
+	runner.run(g, "readAll", [&]() {
+		clobber();
+		sink += drums.joyX() + drums.joyY() + drums.drumRed() + drums.drumBlue() + drums.drumGreen() +
+			drums.cymbalYellow() + drums.cymbalOrange() + drums.bassPedal() +
+			drums.buttonPlus() + drums.buttonMinus() + drums.velocityAvailable();
+	});
+	BENCH_GET(g, drums, velocityID);
+	runner.run(g, "velocity", [&]() { sink += drums.velocity(); });
+	BENCH_GET(g, drums, velocityRed);
+	BENCH_GET(g, drums, velocityBlue);
+	BENCH_GET(g, drums, velocityGreen);
+	BENCH_GET(g, drums, velocityYellow);
+	BENCH_GET(g, drums, velocityOrange);
+	BENCH_GET(g, drums, velocityPedal);
+	runner.run(g, "printDebug", [&]() { drums.printDebug(nullOutput); });
+}
+
+static void benchDJ(Runner & runner) {
+	DJTurntableController dj;
+	connectAs(dj, ExtensionType::DJTurntableController);
+
+	const char * g = "dj";
+	BENCH_GET(g, dj, turntable);
+	BENCH_GET(g, dj, buttonGreen);
+	BENCH_GET(g, dj, buttonRed);
+	BENCH_GET(g, dj, buttonBlue);
+	BENCH_GET(g, dj, effectDial);
+	BENCH_GET(g, dj, crossfadeSlider);
+	BENCH_GET(g, dj, buttonEuphoria);
+	BENCH_GET(g, dj, joyX);
+	BENCH_GET(g, dj, joyY);
+	BENCH_GET(g, dj, buttonPlus);
+	BENCH_GET(g, dj, buttonMinus);
+	runner.run(g, "readAll", [&]() {
+		clobber();
+		sink += dj.effectDial() + dj.crossfadeSlider() + dj.buttonEuphoria() + dj.joyX() + dj.joyY() +
+			dj.buttonPlus() + dj.buttonMinus();
+	});
+	runner.run(g, "left.turntable", [&]() { sink += dj.left.turntable(); });
+	runner.run(g, "right.turntable", [&]() { sink += dj.right.turntable(); });
+	runner.run(g, "getNumTurntables", [&]() { sink += dj.getNumTurntables(); });
+	runner.run(g, "printDebug", [&]() { dj.printDebug(nullOutput); });
+}
+
+static void benchCore(Runner & runner) {
+	uint8_t data[ExtensionController::MaxRequestSize];
+	for (uint8_t i = 0; i < sizeof(data); i++) {
+		data[i] = 0x40 + i;
+	}
+
+	runner.run("core", "verifyData[6]", [&]() { sink += NintendoExtensionCtrl::verifyData(data, 6); });
+	runner.run("core", "verifyData[21]", [&]() { sink += NintendoExtensionCtrl::verifyData(data, 21); });
+	runner.run("core", "identifyController", [&]() {
+		sink += (uint32_t) NintendoExtensionCtrl::identifyController(sim.registerData() + SimulatedController::IdentityStart);
+	});
+	runner.run("core", "printRaw[6]", [&]() { NintendoExtensionCtrl::printRaw(data, 6, HEX, nullOutput); });
+
+	ExtensionPort port;
+	connectAs(port, ExtensionType::ClassicController);
+
+	const uint8_t requestSizes[] = { 6, 8, 10, 15, 21 };
+	for (uint8_t size : requestSizes) {
+		char name[32];
+		snprintf(name, sizeof(name), "update[%u]", size);
+		port.setRequestSize(size);
+		runner.run("transport", name, [&]() { sink += port.update(); });
+	}
+	port.setRequestSize();
+
+	runner.run("transport", "connect", [&]() { sink += port.connect(); });
+}
+
+int main(int argc, char * argv[]) {
+	Runner runner;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--csv") == 0) {
+			runner.setFormat(Runner::Format::CSV);
+		}
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			runner.setFilter(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+			runner.setMinTime((uint32_t) atoi(argv[++i]));
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--csv] [--filter text] [--min-time ms]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);  // Keep stdout for results
+	NXC_Host::defaultBus().attach(SimulatedController::Address, sim);
+
+	runner.header();
+	benchCore(runner);
+	benchNunchuk(runner);
+	benchClassic(runner);
+	benchGuitar(runner);
+	benchDrums(runner);
+	benchDJ(runner);
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Frame latency and fault recovery on the timed bus simulator.
+// Usage: nxc_buslatency [--frames n] [--stretch us] [--conversion us]
+//
+// Writes JSON lines: one "latency" record per clock speed and request size,
+// with the per-phase breakdown of an update(), then one "recovery" record per
+// fault type and recovery policy.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_SimController.h"
+#include "NXC_TimedBus.h"
+
+using NXC_Host::SimulatedController;
+using NXC_Host::TimedBus;
+
+static SimulatedController sim;
+static TimedBus timedBus(NXC_Host::defaultBus());
+
+static uint32_t framesPerRun = 1000;
+
+static double meanUs(TimedBus::Phase p) {
+	const TimedBus::PhaseStats & s = timedBus.stats(p);
+	return s.count ? s.totalUs / s.count : 0.0;
+}
+
+static void measureLatency(ExtensionPort & port, uint32_t clock, uint8_t requestSize) {
+	timedBus.setClock(clock);
+	port.setRequestSize(requestSize);
+	port.update();  // Settle
+
+	timedBus.resetStats();
+	uint32_t failures = 0;
+
+	const uint64_t start = NXC_Host::simulatedTime();
+	for (uint32_t i = 0; i < framesPerRun; i++) {
+		if (!port.update()) failures++;
+	}
+	const double frameUs = (double) (NXC_Host::simulatedTime() - start) / framesPerRun;
+
+	printf("{\"type\":\"latency\",\"clock_hz\":%u,\"request_size\":%u,\"frames\":%u,\"failures\":%u,"
+		"\"pointer_write_us\":%.3f,\"conversion_wait_us\":%.3f,\"read_us\":%.3f,"
+		"\"frame_us\":%.3f,\"max_rate_hz\":%.1f,\"early_reads\":%u}\n",
+		clock, requestSize, framesPerRun, failures,
+		meanUs(TimedBus::Phase::PointerWrite), meanUs(TimedBus::Phase::ConversionWait), meanUs(TimedBus::Phase::Read),
+		frameUs, 1000000.0 / frameUs, timedBus.earlyReads());
+}
+
+enum class Policy { Retry, Reconnect };
+
+// Injects one fault, then updates until a good frame comes back. 'Retry' just
+// calls update() again, 'Reconnect' re-runs the connection sequence after any
+// failed update.
+static void measureRecovery(ExtensionPort & port, TimedBus::FaultType fault, const char * faultName, Policy policy) {
+	timedBus.setClock(400000);
+	port.setRequestSize();
+	port.connect();
+
+	timedBus.clearFaults();
+	timedBus.resetStats();
+	timedBus.injectFault(fault, fault == TimedBus::FaultType::DropBytes ? 2 : 0);
+
+	const uint64_t start = NXC_Host::simulatedTime();
+	uint32_t attempts = 0;
+	bool recovered = false;
+
+	while (attempts < 100) {
+		attempts++;
+		if (port.update() && timedBus.pendingFaults() == 0) {
+			recovered = true;
+			break;
+		}
+		else if (policy == Policy::Reconnect) {
+			port.connect();
+		}
+	}
+
+	printf("{\"type\":\"recovery\",\"fault\":\"%s\",\"policy\":\"%s\",\"recovered\":%s,\"attempts\":%u,\"recovery_us\":%llu,\"faults_fired\":%u}\n",
+		faultName, policy == Policy::Retry ? "retry" : "reconnect", recovered ? "true" : "false", attempts,
+		(unsigned long long) (NXC_Host::simulatedTime() - start), timedBus.faultsFired());
+}
+
+int main(int argc, char * argv[]) {
+	uint32_t conversionUs = NintendoExtensionCtrl::I2C_ConversionDelay;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			framesPerRun = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--stretch") == 0 && i + 1 < argc) {
+			timedBus.setStretch(atof(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--conversion") == 0 && i + 1 < argc) {
+			conversionUs = (uint32_t) atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--frames n] [--stretch us] [--conversion us]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (framesPerRun == 0) framesPerRun = 1;
+
+	Serial.mute(true);
+	NXC_Host::defaultBus().attach(SimulatedController::Address, sim);
+	timedBus.setConversionTime(conversionUs);
+	Wire.setBackend(timedBus);
+
+	ExtensionPort port;
+	port.begin();
+	if (!port.connect()) {
+		fprintf(stderr, "Could not connect to the simulated controller\n");
+		return 1;
+	}
+
+	const uint32_t clocks[] = { 100000, 400000, 1000000 };
+	const uint8_t requestSizes[] = { 6, 8, 10, 15, 21 };
+
+	for (uint32_t clock : clocks) {
+		for (uint8_t size : requestSizes) {
+			measureLatency(port, clock, size);
+		}
+	}
+
+	struct { TimedBus::FaultType type; const char * name; } faults[] = {
+		{ TimedBus::FaultType::AddrNACK, "addr_nack" },
+		{ TimedBus::FaultType::DataNACK, "data_nack" },
+		{ TimedBus::FaultType::ZeroFrame, "zero_frame" },
+		{ TimedBus::FaultType::MaxFrame, "max_frame" },
+		{ TimedBus::FaultType::DropBytes, "drop_bytes" },
+	};
+
+	for (auto & f : faults) {
+		measureRecovery(port, f.type, f.name, Policy::Retry);
+		measureRecovery(port, f.type, f.name, Policy::Reconnect);
+	}
+
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Update coalescing on one simulated port shared by several views.
+// Usage: nxc_coalesce [--seconds s] [--clock hz] [--window us] [--work us]
+//
+// Three subsystems each call update() on their own view of one Classic
+// Controller port every loop: the game input (Classic, with a press event on
+// A), a menu (NES Mini) and a logger (the generic port). Button A is pressed
+// and released every 10 loops. Runs once with coalescing off and once with
+// a '--window' microsecond freshness window, and writes one JSON line per
+// mode with the bus reads per loop, the loop rate, and the press events each
+// event table saw against the presses made.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_SimController.h"
+#include "NXC_TimedBus.h"
+
+#include <string.h>
+
+using NXC_Host::SimulatedController;
+using NXC_Host::TimedBus;
+
+static NXC_Host::SimulatedBus simBus;
+static SimulatedController controller(ExtensionType::ClassicController);
+static TimedBus timedBus(simBus);
+static TwoWire wire(timedBus);
+
+static ExtensionPort port(wire);
+static ClassicController::Shared game(port);
+static NESMiniController::Shared menu(port);
+
+static uint32_t gamePresses = 0;
+static uint32_t menuPresses = 0;
+
+static void pressGame() { gamePresses++; }
+static void pressMenu() { menuPresses++; }
+
+static const uint8_t ButtonByte = 5;
+static const uint8_t ButtonA = 1 << 4;  // Inverted, '0' is pressed
+
+static uint32_t workUs = 1000;
+
+static void runMode(const char * mode, uint16_t window, uint64_t duration) {
+	port.setFreshness(window);
+	gamePresses = 0;
+	menuPresses = 0;
+
+	const uint32_t startReads = controller.readCount();
+	const uint64_t start = NXC_Host::simulatedTime();
+	uint32_t loops = 0;
+	uint32_t presses = 0;
+	uint32_t failures = 0;
+	uint32_t mismatches = 0;
+
+	while (NXC_Host::simulatedTime() - start < duration) {
+		const boolean pressed = (loops % 10) == 5;  // Held for one loop in ten
+		controller.setControlData(ButtonByte, pressed ? 0xFF & ~ButtonA : 0xFF);
+		if (pressed) presses++;
+
+		failures += !game.update();
+		if (game.buttonA() != pressed) mismatches++;
+
+		failures += !menu.update();
+		if (menu.buttonA() != pressed) mismatches++;
+
+		failures += !port.update();
+		if (port.getControlData(ButtonByte) != controller.registerData()[ButtonByte]) mismatches++;
+
+		delayMicroseconds(workUs);
+		loops++;
+	}
+
+	const double seconds = (NXC_Host::simulatedTime() - start) / 1000000.0;
+	const uint32_t reads = controller.readCount() - startReads;
+
+	printf("{\"mode\":\"%s\",\"window_us\":%u,\"loops_per_s\":%.1f,\"reads_per_loop\":%.3f,\"failures\":%u,\"mismatches\":%u,"
+		"\"presses\":%u,\"game_events\":%u,\"menu_events\":%u}\n",
+		mode, window, loops / seconds, (double) reads / loops, failures, mismatches,
+		presses, gamePresses, menuPresses);
+}
+
+int main(int argc, char * argv[]) {
+	uint32_t seconds = 10;
+	uint32_t clock = 400000;
+	uint32_t window = 500;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+			seconds = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--clock") == 0 && i + 1 < argc) {
+			clock = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+			window = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--work") == 0 && i + 1 < argc) {
+			workUs = (uint32_t) atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--seconds s] [--clock hz] [--window us] [--work us]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (window == 0 || window > 0xFFFF) {
+		fprintf(stderr, "The window must be 1 to 65535 us\n");
+		return 1;
+	}
+
+	Serial.mute(true);
+
+	simBus.attach(SimulatedController::Address, controller);
+	port.begin();
+	wire.setClock(clock);
+	if (!port.connect()) {
+		fprintf(stderr, "Could not connect to the simulated controller\n");
+		return 1;
+	}
+
+	NintendoExtensionCtrl::ControlEventTable<1> gameEvents;
+	gameEvents.onPress(ClassicController::Maps::ButtonA, pressGame);
+	game.attachEvents(gameEvents);
+
+	NintendoExtensionCtrl::ControlEventTable<1> menuEvents;
+	menuEvents.onPress(ClassicController::Maps::ButtonA, pressMenu);
+	menu.attachEvents(menuEvents);
+
+	const uint64_t duration = (uint64_t) seconds * 1000000;
+	runMode("every_update", 0, duration);
+	runMode("coalesced", (uint16_t) window, duration);
+
+	return 0;
+}
@@ -0,0 +1,192 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Split-phase updates on two i2c_t3 buses at once, against blocking
+// updates one bus after the other. Usage: nxc_concurrent [--rounds n] [--clock hz]
+//
+// Each bus has a Classic Controller on a mock i2c_t3 (sim/NXC_MockI2CT3.h),
+// which models transfer times and the controller's conversion time. Every
+// round changes both controllers' data, updates both ports, and checks what
+// they read. Writes one JSON line per mode with the aggregate update rate,
+// failures, timeouts, mismatched frames, reads started too early, and how
+// busy each bus was. The last two modes hold bus 1 stuck, to check that
+// updateAll() still returns and bus 0 keeps updating, first with a timeout
+// passed to updateAll() and then with one set on bus 1's port.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_SimController.h"
+#include "NXC_MockI2CT3.h"
+
+#include <string.h>
+
+using NXC_Host::SimulatedController;
+using NintendoExtensionCtrl::SplitUpdate;
+
+typedef NintendoExtensionCtrl::BuildControllerClass<ClassicController::Shared, i2c_t3> ClassicT3;
+
+struct Channel {
+	NXC_Host::SimulatedBus sim;
+	SimulatedController controller;
+	i2c_t3 wire;
+	ClassicT3 port;
+
+	Channel() : controller(ExtensionType::ClassicController), wire(sim), port(wire) {}
+};
+
+static Channel channels[2];
+
+static uint32_t failures = 0;
+static uint32_t timeouts = 0;
+static uint32_t mismatches = 0;
+
+static void setRound(uint32_t round) {
+	for (uint8_t i = 0; i < 2; i++) {
+		const uint8_t x = (uint8_t) ((round + i * 17) & 0x3F);
+		channels[i].controller.setControlData(0, (uint8_t) ((channels[i].controller.registerData()[0] & 0xC0) | x));
+	}
+}
+
+static void checkRound(uint32_t round, uint8_t i, boolean success) {
+	if (!success) {
+		failures++;
+		return;
+	}
+	const uint8_t x = (uint8_t) ((round + i * 17) & 0x3F);
+	if (channels[i].port.leftJoyX() != x) mismatches++;
+}
+
+template<class Fn>
+static void runMode(const char * mode, uint32_t rounds, Fn updateBoth) {
+	failures = 0;
+	timeouts = 0;
+	mismatches = 0;
+
+	uint32_t startEarly[2];
+	double startBusy[2];
+	for (uint8_t i = 0; i < 2; i++) {
+		startEarly[i] = channels[i].wire.earlyReads();
+		startBusy[i] = channels[i].wire.busyTime();
+	}
+
+	const unsigned long start = micros();
+	for (uint32_t r = 0; r < rounds; r++) {
+		setRound(r);
+		updateBoth(r);
+	}
+	const double elapsed = (double) (micros() - start);
+
+	uint32_t early = 0;
+	for (uint8_t i = 0; i < 2; i++) early += channels[i].wire.earlyReads() - startEarly[i];
+
+	printf("{\"mode\":\"%s\",\"rounds\":%u,\"us_per_round\":%.1f,\"updates_per_s\":%.0f,\"failures\":%u,\"timeouts\":%u,\"mismatches\":%u,"
+		"\"early_reads\":%u,\"bus0_busy_pct\":%.1f,\"bus1_busy_pct\":%.1f}\n",
+		mode, rounds, elapsed / rounds, (2.0 * rounds - failures) * 1000000.0 / elapsed, failures, timeouts, mismatches, early,
+		100.0 * (channels[0].wire.busyTime() - startBusy[0]) / elapsed,
+		100.0 * (channels[1].wire.busyTime() - startBusy[1]) / elapsed);
+}
+
+int main(int argc, char * argv[]) {
+	uint32_t rounds = 2000;
+	uint32_t clock = 400000;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+			rounds = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--clock") == 0 && i + 1 < argc) {
+			clock = (uint32_t) atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--rounds n] [--clock hz]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);
+
+	for (Channel & c : channels) {
+		c.sim.attach(SimulatedController::Address, c.controller);
+		c.wire.setClock(clock);
+		c.wire.setConversionTime(150);  // A little under the library's wait
+		c.port.begin();
+		if (!c.port.connect()) {
+			fprintf(stderr, "Could not connect to a simulated controller\n");
+			return 1;
+		}
+	}
+
+	// One bus after the other, blocking
+	runMode("blocking", rounds, [](uint32_t r) {
+		for (uint8_t i = 0; i < 2; i++) {
+			checkRound(r, i, channels[i].port.update());
+		}
+	});
+
+	// Split updates, still one bus at a time
+	SplitUpdate<i2c_t3> single[2][1] = { { channels[0].port }, { channels[1].port } };
+	runMode("split_sequential", rounds, [&](uint32_t r) {
+		for (uint8_t i = 0; i < 2; i++) {
+			NintendoExtensionCtrl::updateAll(single[i]);
+			checkRound(r, i, single[i][0].succeeded());
+		}
+	});
+
+	// Split updates on both buses at once
+	SplitUpdate<i2c_t3> both[] = { channels[0].port, channels[1].port };
+	runMode("split_concurrent", rounds, [&](uint32_t r) {
+		NintendoExtensionCtrl::updateAll(both);
+		for (uint8_t i = 0; i < 2; i++) {
+			checkRound(r, i, both[i].succeeded());
+		}
+	});
+
+	// Bus 1 never finishes a transfer, and each of its updates times out
+	const unsigned long timeout = 2000;
+	channels[1].wire.setStuck(true);
+	runMode("split_stuck_bus1", rounds / 10, [&](uint32_t r) {
+		NintendoExtensionCtrl::updateAll(both, timeout);
+		for (uint8_t i = 0; i < 2; i++) {
+			checkRound(r, i, both[i].succeeded());
+			if (both[i].hasTimedOut()) timeouts++;
+		}
+	});
+
+	// Same, with bus 1's own timeout, which updateAll() has to leave alone
+	const unsigned long portTimeout = 1000;
+	both[1].setTimeout(portTimeout);
+	runMode("split_stuck_bus1_port_timeout", rounds / 10, [&](uint32_t r) {
+		NintendoExtensionCtrl::updateAll(both);
+		for (uint8_t i = 0; i < 2; i++) {
+			checkRound(r, i, both[i].succeeded());
+			if (both[i].hasTimedOut()) timeouts++;
+		}
+	});
+	channels[1].wire.setStuck(false);
+
+	if (both[0].getTimeout() != timeout || both[1].getTimeout() != portTimeout) {
+		fprintf(stderr, "updateAll() changed a port's timeout: %lu, %lu\n", both[0].getTimeout(), both[1].getTimeout());
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,264 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// HID report builder check and benchmark. Usage: nxc_hidreport [--csv] [--min-time ms]
+//
+// For every controller type, builds reports for all 65536 values of the
+// button bytes (4 and 5), with random bytes 0-3, and compares each one to a
+// report packed from the controller's accessors. Then times both ways of
+// building a report. Writes one JSON line per type, then the benchmark
+// results.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_Bench.h"
+
+#include <string.h>
+
+using namespace NXC_Bench;
+using NintendoExtensionCtrl::HIDReportBuilder;
+using NintendoExtensionCtrl::ButtonRemap;
+using NintendoExtensionCtrl::VirtualGamepad;
+
+// Port with control data loaded directly, for the accessors to read
+class FramePort : public ExtensionPort {
+public:
+	void load(const uint8_t * data) {
+		for (uint8_t i = 0; i < HIDReportBuilder::DataSize; i++) {
+			setControlData(i, data[i]);
+		}
+	}
+};
+
+// Same widening as the builder: repeat the top bits down to 8 bits
+static uint8_t expand(uint8_t value, uint8_t bits) {
+	return (value << (8 - bits)) | (value >> (2 * bits - 8));
+}
+
+static void setButton(uint16_t & buttons, boolean pressed, VirtualGamepad::Button b) {
+	if (pressed) buttons |= b;
+}
+
+// Packs a report by calling each accessor
+static void referenceReport(ExtensionType type, FramePort & port, uint8_t * report) {
+	uint16_t buttons = 0;
+	uint8_t * axes = report + 2;
+	memset(axes, 0x80, HIDReportBuilder::NumAxes);
+
+	typedef VirtualGamepad G;
+
+	switch (type) {
+	case(ExtensionType::Nunchuk): {
+		Nunchuk::Shared c(port.getExtensionData());
+		setButton(buttons, c.buttonC(), G::A);
+		setButton(buttons, c.buttonZ(), G::B);
+		axes[0] = c.joyX();
+		axes[1] = 255 - c.joyY();
+		axes[2] = c.accelX() >> 2;
+		axes[3] = c.accelY() >> 2;
+		axes[5] = c.accelZ() >> 2;
+		break;
+	}
+	case(ExtensionType::ClassicController): {
+		ClassicController::Shared c(port.getExtensionData());
+		setButton(buttons, c.buttonA(), G::A);
+		setButton(buttons, c.buttonB(), G::B);
+		setButton(buttons, c.buttonX(), G::X);
+		setButton(buttons, c.buttonY(), G::Y);
+		setButton(buttons, c.buttonL(), G::L);
+		setButton(buttons, c.buttonR(), G::R);
+		setButton(buttons, c.buttonZL(), G::ZL);
+		setButton(buttons, c.buttonZR(), G::ZR);
+		setButton(buttons, c.buttonPlus(), G::Start);
+		setButton(buttons, c.buttonMinus(), G::Select);
+		setButton(buttons, c.buttonHome(), G::Home);
+		setButton(buttons, c.dpadUp(), G::DpadUp);
+		setButton(buttons, c.dpadDown(), G::DpadDown);
+		setButton(buttons, c.dpadLeft(), G::DpadLeft);
+		setButton(buttons, c.dpadRight(), G::DpadRight);
+		axes[0] = expand(c.leftJoyX(), 6);
+		axes[1] = 255 - expand(c.leftJoyY(), 6);
+		axes[2] = expand(c.rightJoyX(), 5);
+		axes[3] = 255 - expand(c.rightJoyY(), 5);
+		axes[4] = expand(c.triggerL(), 5);
+		axes[5] = expand(c.triggerR(), 5);
+		break;
+	}
+	case(ExtensionType::GuitarController): {
+		GuitarController::Shared c(port.getExtensionData());
+		setButton(buttons, c.fretGreen(), G::A);
+		setButton(buttons, c.fretRed(), G::B);
+		setButton(buttons, c.fretYellow(), G::Y);
+		setButton(buttons, c.fretBlue(), G::X);
+		setButton(buttons, c.fretOrange(), G::L);
+		setButton(buttons, c.strumUp(), G::DpadUp);
+		setButton(buttons, c.strumDown(), G::DpadDown);
+		setButton(buttons, c.buttonPlus(), G::Start);
+		setButton(buttons, c.buttonMinus(), G::Select);
+		axes[0] = expand(c.joyX(), 6);
+		axes[1] = 255 - expand(c.joyY(), 6);
+		axes[4] = expand(c.whammyBar(), 5);
+		axes[5] = expand(c.touchbar(), 5);
+		break;
+	}
+	case(ExtensionType::DrumController): {
+		DrumController::Shared c(port.getExtensionData());
+		setButton(buttons, c.drumGreen(), G::A);
+		setButton(buttons, c.drumRed(), G::B);
+		setButton(buttons, c.cymbalYellow(), G::Y);
+		setButton(buttons, c.drumBlue(), G::X);
+		setButton(buttons, c.cymbalOrange(), G::R);
+		setButton(buttons, c.bassPedal(), G::L);
+		setButton(buttons, c.buttonPlus(), G::Start);
+		setButton(buttons, c.buttonMinus(), G::Select);
+		axes[0] = expand(c.joyX(), 6);
+		axes[1] = 255 - expand(c.joyY(), 6);
+		break;
+	}
+	case(ExtensionType::DJTurntableController): {
+		DJTurntableController::Shared c(port.getExtensionData());
+		setButton(buttons, c.left.buttonGreen() || c.right.buttonGreen(), G::A);
+		setButton(buttons, c.left.buttonRed() || c.right.buttonRed(), G::B);
+		setButton(buttons, c.left.buttonBlue() || c.right.buttonBlue(), G::X);
+		setButton(buttons, c.buttonEuphoria(), G::Y);
+		setButton(buttons, c.buttonPlus(), G::Start);
+		setButton(buttons, c.buttonMinus(), G::Select);
+		axes[0] = expand(c.joyX(), 6);
+		axes[1] = 255 - expand(c.joyY(), 6);
+		axes[2] = expand(c.left.turntable() + 32, 6);
+		axes[3] = expand(c.right.turntable() + 32, 6);
+		axes[4] = expand(c.crossfadeSlider() + 8, 4);
+		axes[5] = expand(c.effectDial(), 5);
+		break;
+	}
+	default:
+		break;
+	}
+
+	report[0] = buttons & 0xFF;
+	report[1] = buttons >> 8;
+}
+
+struct TypeInfo {
+	const char * name;
+	ExtensionType type;
+};
+
+static const TypeInfo Types[] = {
+	{ "nunchuk", ExtensionType::Nunchuk },
+	{ "classic", ExtensionType::ClassicController },
+	{ "guitar", ExtensionType::GuitarController },
+	{ "drums", ExtensionType::DrumController },
+	{ "dj", ExtensionType::DJTurntableController },
+	{ "none", ExtensionType::NoController },
+};
+
+static uint32_t xorshift(uint32_t & state) {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+int main(int argc, char * argv[]) {
+	Runner runner;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--csv") == 0) {
+			runner.setFormat(Runner::Format::CSV);
+		}
+		else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+			runner.setMinTime((uint32_t) atoi(argv[++i]));
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--csv] [--min-time ms]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);
+
+	FramePort port;
+	ButtonRemap remap;
+	HIDReportBuilder builder(remap);
+	uint32_t state = 1;
+	uint32_t totalMismatches = 0;
+
+	for (const TypeInfo & t : Types) {
+		uint32_t mismatches = 0;
+		uint32_t changes = 0;
+		uint8_t data[HIDReportBuilder::DataSize];
+
+		for (uint32_t buttons = 0; buttons < 0x10000; buttons++) {
+			const uint32_t r = xorshift(state);
+			for (uint8_t i = 0; i < 4; i++) {
+				data[i] = r >> (8 * i);
+			}
+			data[4] = buttons & 0xFF;
+			data[5] = buttons >> 8;
+			port.load(data);
+
+			uint8_t expected[HIDReportBuilder::ReportSize];
+			referenceReport(t.type, port, expected);
+
+			changes += builder.build(t.type, data);
+			if (memcmp(builder.getReport(), expected, sizeof(expected)) != 0) {
+				if (mismatches == 0) {
+					fprintf(stderr, "%s: data", t.name);
+					for (uint8_t b : data) fprintf(stderr, " %02X", b);
+					fprintf(stderr, ", report");
+					for (uint8_t i = 0; i < HIDReportBuilder::ReportSize; i++) fprintf(stderr, " %02X", builder.getReport()[i]);
+					fprintf(stderr, ", expected");
+					for (uint8_t b : expected) fprintf(stderr, " %02X", b);
+					fprintf(stderr, "\n");
+				}
+				mismatches++;
+			}
+		}
+
+		if (builder.build(t.type, data)) mismatches++;  // The same frame again is not a change
+
+		printf("{\"type\":\"%s\",\"frames\":65536,\"changes\":%u,\"mismatches\":%u}\n", t.name, changes, mismatches);
+		totalMismatches += mismatches;
+	}
+
+	// Timing, on a frame that changes every iteration so nothing is skipped
+	for (const TypeInfo & t : Types) {
+		if (t.type == ExtensionType::NoController) continue;
+
+		uint8_t data[HIDReportBuilder::DataSize] = { 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF };
+		port.load(data);
+		uint8_t report[HIDReportBuilder::ReportSize];
+
+		runner.run(t.name, "build[tables]", [&]() {
+			data[0]++;
+			sink += builder.build(t.type, data);
+		});
+		runner.run(t.name, "build[accessors]", [&]() {
+			port.load(data);
+			referenceReport(t.type, port, report);
+			sink += report[2];
+		});
+	}
+
+	return totalMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Syscall and timing comparison for the Linux i2c-dev backend.
+// Usage: nxc_i2cdev [--device /dev/i2c-N] [--frames n] [--size n] [--interval us]
+//
+// Polls a Classic Controller through LinuxI2CBus in each mode (read/write,
+// combined I2C_RDWR, and pipelined) and writes one JSON line per mode:
+// syscalls, I2C messages and bus waits per frame, host time per frame, and
+// the poll period. Without '--device' the bus runs on FakeI2CDev with a
+// simulated controller, so the syscall counts are exact and the waits are
+// fake time; the fake also checks that no read comes before the controller's
+// conversion time. With '--device' it runs against real hardware.
+//
+// '--interval' sets a poll period. Pipelined mode only saves the conversion
+// wait when the period is longer than the conversion time.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_FakeI2CDev.h"
+#include "NXC_LinuxI2C.h"
+#include "NXC_SimController.h"
+
+#include <string.h>
+
+using NXC_Host::FakeI2CDev;
+using NXC_Host::I2CDevSyscalls;
+using NXC_Host::LinuxI2CBus;
+using NXC_Host::SimulatedController;
+
+struct Options {
+	const char * device = nullptr;
+	uint32_t frames = 100000;
+	uint8_t size = ExtensionController::MinRequestSize;
+	uint32_t intervalUs = 0;
+};
+
+static int runMode(LinuxI2CBus::Mode mode, const Options & opt) {
+	NXC_Host::SimulatedBus simBus;
+	SimulatedController sim(ExtensionType::ClassicController);
+	simBus.attach(SimulatedController::Address, sim);
+
+	FakeI2CDev fake(simBus);
+	fake.setConversionTime(NintendoExtensionCtrl::I2C_ConversionDelay);
+
+	const bool hardware = opt.device != nullptr;
+	I2CDevSyscalls & sys = hardware ? I2CDevSyscalls::system() : fake;
+
+	LinuxI2CBus bus(hardware ? opt.device : "/dev/i2c-fake", mode, sys);
+	TwoWire wire(bus);
+	ClassicController classic(wire);
+
+	classic.begin();
+	if (!bus.isOpen()) {
+		fprintf(stderr, "Could not open '%s': %s\n", opt.device, strerror(bus.lastError()));
+		return 1;
+	}
+	if (!classic.connect()) {
+		fprintf(stderr, "No controller found (%s mode)\n", LinuxI2CBus::modeName(mode));
+		return 1;
+	}
+	classic.setRequestSize(opt.size);
+
+	bus.resetCounters();
+	fake.resetCalls();
+
+	uint32_t failures = 0;
+	uint32_t mismatches = 0;
+	uint8_t data[6];
+	memcpy(data, sim.registerData(), sizeof(data));
+
+	const uint64_t hostStart = NXC_Host::nanos();
+	const uint64_t start = sys.now();
+	uint64_t tick = start;
+
+	for (uint32_t i = 0; i < opt.frames; i++) {
+		if (opt.intervalUs) {
+			tick += (uint64_t) opt.intervalUs * 1000;
+			sys.sleepUntil(tick);
+		}
+
+		if (!hardware) {
+			data[0] = (data[0] & 0xC0) | (i & 0x3F);  // Left stick X, so every frame differs
+			sim.setControlData(data, sizeof(data));
+		}
+
+		if (!classic.update()) {
+			failures++;
+		}
+		else if (!hardware && classic.leftJoyX() != (i & 0x3F)) {
+			mismatches++;
+		}
+	}
+
+	const double hostNs = (double) (NXC_Host::nanos() - hostStart);
+	const double periodNs = (double) (sys.now() - start);
+	const LinuxI2CBus::Counters & c = bus.counters();
+	const double n = opt.frames;
+
+	printf("{\"mode\":\"%s\",\"device\":\"%s\",\"request_size\":%u,\"frames\":%u,\"failures\":%u,"
+		"\"syscalls_per_frame\":%.3f,\"messages_per_frame\":%.3f,\"skipped_writes\":%u,"
+		"\"sleeps_per_frame\":%.3f,\"wait_us_per_frame\":%.3f,\"host_ns_per_frame\":%.1f,\"period_us\":%.3f",
+		LinuxI2CBus::modeName(mode), hardware ? opt.device : "fake", opt.size, opt.frames, failures,
+		c.syscalls / n, c.messages / n, c.skippedWrites,
+		c.sleeps / n, c.sleepNs / n / 1000.0, hostNs / n, periodNs / n / 1000.0);
+	if (!hardware) {
+		printf(",\"early_reads\":%u,\"mismatches\":%u", fake.earlyReads(), mismatches);
+	}
+	printf("}\n");
+	return 0;
+}
+
+int main(int argc, char * argv[]) {
+	Options opt;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--device") == 0 && i + 1 < argc) {
+			opt.device = argv[++i];
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			opt.frames = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+			opt.size = (uint8_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+			opt.intervalUs = (uint32_t) atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--device /dev/i2c-N] [--frames n] [--size n] [--interval us]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (opt.frames == 0) opt.frames = 1;
+
+	const LinuxI2CBus::Mode modes[] = {
+		LinuxI2CBus::Mode::ReadWrite,
+		LinuxI2CBus::Mode::Combined,
+		LinuxI2CBus::Mode::Pipelined,
+	};
+
+	Serial.mute(true);
+	for (LinuxI2CBus::Mode m : modes) {
+		if (runMode(m, opt) != 0) return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,152 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Checks that an NES knockoff's frames are fixed up before the events and
+// the axis filter see them. Usage: nxc_knockoff [--frames n]
+//
+// A simulated knockoff reports the usual 0x81 0x81 0x81 0x81 0x00 0x00
+// pattern, with its buttons in bytes 6 and 7 following a random walk. The
+// sketch calls fixKnockoffData() after each update(), like the NES examples.
+// Press and release events for A are counted against the presses in the
+// walk. On the raw frames every button reads as held, so no events fire.
+// The second mode adds stick deadzones. On the raw frame the right stick's
+// snaps to center, which changes bytes 0-2 so the frame no longer looks
+// like a knockoff's. Writes one JSON line per mode, and fails if any count
+// is off.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_SimController.h"
+
+#include <string.h>
+
+using NXC_Host::SimulatedController;
+
+static uint32_t presses = 0;
+static uint32_t releases = 0;
+
+static void pressA() { presses++; }
+static void releaseA() { releases++; }
+
+static bool pressedA(const uint8_t * data) {
+	return !(data[7] & (1 << ClassicController::Maps::ButtonA.position));  // Moved to byte 5 by the fixup
+}
+
+static NXC_Host::SimulatedBus bus;
+static SimulatedController sim(ExtensionType::ClassicController);
+static TwoWire wire(bus);
+static NESMiniController nes(wire);
+
+static bool runMode(const char * mode, uint32_t frames, NintendoExtensionCtrl::AxisFilter * filter) {
+	uint8_t data[8] = { 0x81, 0x81, 0x81, 0x81, 0x00, 0x00, 0xFF, 0xFF };
+	sim.setControlData(data, sizeof(data));
+
+	if (!nes.connect()) {
+		fprintf(stderr, "Could not connect to a simulated knockoff\n");
+		return false;
+	}
+	nes.fixKnockoffData();  // Attaches the fixup, which runs from the next update()
+
+	NintendoExtensionCtrl::ControlEventTable<2> events;
+	events.onPress(ClassicController::Maps::ButtonA, pressA);
+	events.onRelease(ClassicController::Maps::ButtonA, releaseA);
+	nes.attachEvents(events);
+
+	if (filter != nullptr) nes.attachFilter(*filter);
+
+	presses = 0;
+	releases = 0;
+
+	uint32_t expectPresses = 0;
+	uint32_t expectReleases = 0;
+	uint32_t unfixed = 0;
+	uint32_t mismatches = 0;
+
+	uint32_t state = 1;
+	bool last = pressedA(data);
+	bool seeded = false;  // The events take their first frame as the baseline
+
+	for (uint32_t f = 0; f < frames; f++) {
+		// xorshift32 random walk, flipping a button bit now and then
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		if ((state >> 8) % 4 == 0) data[6 + (state & 1)] ^= 1 << ((state >> 11) % 8);
+		sim.setControlData(data, sizeof(data));
+
+		if (!nes.update()) {
+			fprintf(stderr, "Update failed on frame %u\n", f);
+			return false;
+		}
+		if (!nes.fixKnockoffData()) unfixed++;
+
+		const bool a = pressedA(data);
+		if (seeded && a && !last) expectPresses++;
+		if (seeded && !a && last) expectReleases++;
+		last = a;
+		seeded = true;
+
+		if (nes.buttonA() != a) mismatches++;
+		if (filter != nullptr && (nes.leftJoyX() != 32 || nes.rightJoyX() != 16)) mismatches++;  // Both centered
+	}
+
+	nes.detachEvents();
+	nes.detachFilter();
+
+	printf("{\"mode\":\"%s\",\"frames\":%u,\"presses\":%u,\"expected_presses\":%u,\"releases\":%u,\"expected_releases\":%u,"
+		"\"unfixed\":%u,\"mismatches\":%u}\n",
+		mode, frames, presses, expectPresses, releases, expectReleases, unfixed, mismatches);
+
+	return presses == expectPresses && releases == expectReleases && expectPresses > 0 &&
+		unfixed == 0 && mismatches == 0;
+}
+
+int main(int argc, char * argv[]) {
+	uint32_t frames = 5000;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = (uint32_t) atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--frames n]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);
+
+	bus.attach(SimulatedController::Address, sim);
+	nes.begin();
+	nes.setRequestSize(8);  // Knockoffs put their buttons in bytes 6 and 7
+
+	bool ok = runMode("events", frames, nullptr);
+
+	// Fixed up, the sticks rest at 31 and 15. Raw, the right stick reads 21,
+	// which its deadzone would snap to 16.
+	NintendoExtensionCtrl::AxisFilterTable<2> filter;
+	filter.add(ClassicController::Maps::LeftJoyX, 1, 4, 32);
+	filter.add(ClassicController::Maps::RightJoyX, 1, 5, 16);
+	ok = runMode("events_filter", frames, &filter) && ok;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// MultiController against the MultipleTypes example's approach: a generic
+// port, one 'Shared' object per type, and a switch on the type every frame.
+// Usage: nxc_multi [--csv] [--min-time ms]
+//
+// Connects each library type in turn, plus an NES knockoff, and checks that
+// both ways give the same debug output. Then writes the RAM each way takes
+// and times update() plus printDebug() for each.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_Bench.h"
+#include "NXC_SimController.h"
+
+using namespace NXC_Bench;
+using NXC_Host::SimulatedController;
+
+// Keeps the last line printed, for comparing the two ways
+class LinePrint : public Print {
+public:
+	size_t write(uint8_t c) override {
+		if (length < sizeof(line) - 1) line[length++] = (char) c;
+		line[length] = '\0';
+		return 1;
+	}
+
+	void clear() { length = 0; line[0] = '\0'; }
+	const char * get() const { return line; }
+
+private:
+	char line[256] = {};
+	size_t length = 0;
+};
+
+struct PrintDebug {
+	Print & out;
+	template<class Controller>
+	void operator()(Controller & c) const { c.printDebug(out); }
+};
+
+typedef NintendoExtensionCtrl::MultiController<
+	Nunchuk, NESMiniController, GuitarController, DrumController, DJTurntableController> Multi;
+
+static SimulatedController sim;
+
+// The MultipleTypes example, with a knockoff fix like the NES examples
+static ExtensionPort port;
+static Nunchuk::Shared nchuk(port);
+static NESMiniController::Shared nes(port);
+static GuitarController::Shared guitar(port);
+static DrumController::Shared drums(port);
+static DJTurntableController::Shared dj(port);
+
+static boolean switchConnect() {
+	port.setRequestSize();
+	if (!port.connect()) return false;
+	if (port.getControllerType() == ExtensionType::ClassicController) {
+		port.setRequestSize(8);
+		return port.update();
+	}
+	return true;
+}
+
+static boolean switchFrame(Print & out) {
+	if (!port.update()) return false;
+
+	switch (port.getControllerType()) {
+		case(ExtensionType::Nunchuk):
+			nchuk.printDebug(out);
+			break;
+		case(ExtensionType::ClassicController):
+			nes.fixKnockoffData();
+			nes.printDebug(out);
+			break;
+		case(ExtensionType::GuitarController):
+			guitar.printDebug(out);
+			break;
+		case(ExtensionType::DrumController):
+			drums.printDebug(out);
+			break;
+		case(ExtensionType::DJTurntableController):
+			dj.printDebug(out);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+static boolean multiFrame(Multi & multi, Print & out) {
+	return multi.update() && multi.visit(PrintDebug{ out });
+}
+
+static void setup(ExtensionType type, boolean knockoff) {
+	sim.setType(type);
+	sim.reset();
+	if (knockoff) {
+		const uint8_t data[8] = { 0x81, 0x81, 0x81, 0x81, 0x00, 0x00, 0xFF, 0xFF };
+		sim.setControlData(data, sizeof(data));
+	}
+}
+
+int main(int argc, char * argv[]) {
+	Runner runner;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--csv") == 0) {
+			runner.setFormat(Runner::Format::CSV);
+		}
+		else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+			runner.setMinTime((uint32_t) atoi(argv[++i]));
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--csv] [--min-time ms]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);
+	NXC_Host::defaultBus().attach(SimulatedController::Address, sim);
+
+	Multi multi;
+	multi.begin();
+	port.begin();
+
+	struct Case {
+		const char * name;
+		ExtensionType type;
+		boolean knockoff;
+	};
+	const Case cases[] = {
+		{ "nunchuk", ExtensionType::Nunchuk, false },
+		{ "nes", ExtensionType::ClassicController, false },
+		{ "nes_knockoff", ExtensionType::ClassicController, true },
+		{ "guitar", ExtensionType::GuitarController, false },
+		{ "drums", ExtensionType::DrumController, false },
+		{ "dj", ExtensionType::DJTurntableController, false },
+	};
+
+	LinePrint multiOut, switchOut;
+	uint32_t failures = 0;
+
+	for (const Case & c : cases) {
+		setup(c.type, c.knockoff);
+		const boolean multiOk = multi.connect() && multiFrame(multi, multiOut);
+
+		setup(c.type, c.knockoff);
+		const boolean switchOk = switchConnect() && switchFrame(switchOut);
+
+		const boolean match = multiOk && switchOk && strcmp(multiOut.get(), switchOut.get()) == 0;
+		if (!match) failures++;
+
+		printf("{\"check\":\"%s\",\"slot\":%d,\"request_size\":%u,\"match\":%s}\n",
+			c.name, multi.getSlot(), multi.getRequestSize(), match ? "true" : "false");
+		multiOut.clear();
+		switchOut.clear();
+	}
+
+	const size_t switchBytes = sizeof(port) + sizeof(nchuk) + sizeof(nes) + sizeof(guitar) + sizeof(drums) + sizeof(dj);
+	printf("{\"ram\":true,\"multi_bytes\":%u,\"switch_bytes\":%u}\n", (unsigned) sizeof(multi), (unsigned) switchBytes);
+
+	runner.header();
+	NullPrint nullOutput;
+	for (const Case & c : cases) {
+		char name[48];
+
+		setup(c.type, c.knockoff);
+		multi.connect();
+		snprintf(name, sizeof(name), "%s[multi]", c.name);
+		runner.run("frame", name, [&]() { sink += multiFrame(multi, nullOutput); });
+
+		setup(c.type, c.knockoff);
+		switchConnect();
+		snprintf(name, sizeof(name), "%s[switch]", c.name);
+		runner.run("frame", name, [&]() { sink += switchFrame(nullOutput); });
+	}
+
+	return failures == 0 ? 0 : 1;
+}
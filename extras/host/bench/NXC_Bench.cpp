@@ -0,0 +1,53 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Bench.h"
+
+namespace NXC_Bench {
+	volatile uint32_t sink = 0;
+
+	void Runner::header() {
+		if (format == Format::CSV) {
+			fprintf(out, "group,name,iterations,ns_per_op,sim_us_per_op\n");
+		}
+	}
+
+	bool Runner::selected(const char * group, const char * name) const {
+		if (filter == nullptr) return true;
+
+		char fullName[128];
+		snprintf(fullName, sizeof(fullName), "%s.%s", group, name);
+		return strstr(fullName, filter) != nullptr;
+	}
+
+	void Runner::report(const char * group, const char * name, uint64_t iterations, double nsPerOp, double simUsPerOp) {
+		if (format == Format::CSV) {
+			fprintf(out, "%s,%s,%llu,%.3f,%.3f\n", group, name,
+				(unsigned long long) iterations, nsPerOp, simUsPerOp);
+		}
+		else {
+			fprintf(out, "{\"group\":\"%s\",\"name\":\"%s\",\"iterations\":%llu,\"ns_per_op\":%.3f,\"sim_us_per_op\":%.3f}\n",
+				group, name, (unsigned long long) iterations, nsPerOp, simUsPerOp);
+		}
+		fflush(out);
+	}
+}
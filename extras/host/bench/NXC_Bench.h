@@ -0,0 +1,105 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Bench_h
+#define NXC_Bench_h
+
+#include <Arduino.h>
+
+namespace NXC_Bench {
+	extern volatile uint32_t sink;  // Results go here so they aren't optimized away
+
+	// Compiler barrier, so inlined reads of control data aren't hoisted out of the loop
+	inline void clobber() { asm volatile("" ::: "memory"); }
+
+	// Print that discards everything, for timing the debug output
+	class NullPrint : public Print {
+	public:
+		size_t write(uint8_t) override { return 1; }
+		size_t write(const uint8_t *, size_t size) override { return size; }
+		int availableForWrite() override { return 64; }
+	};
+
+	// Print that writes to a stdio file
+	class FilePrint : public Print {
+	public:
+		FilePrint(FILE * f) : file(f) {}
+		size_t write(uint8_t c) override { return fputc(c, file) == EOF ? 0 : 1; }
+		size_t write(const uint8_t * data, size_t size) override { return fwrite(data, 1, size, file); }
+	private:
+		FILE * file;
+	};
+
+	// Runs each benchmark for at least 'minTime', doubling the iteration count
+	// until it does, and writes one result per line. JSON lines by default:
+	//   {"group":"classic","name":"buttonA","iterations":1048576,"ns_per_op":1.9,"sim_us_per_op":0}
+	// 'sim_us_per_op' is the simulated delay time (bus waits) per call.
+	class Runner {
+	public:
+		enum class Format { JSON, CSV };
+
+		Runner(FILE * output = stdout) : out(output) {}
+
+		void setFormat(Format f) { format = f; }
+		void setMinTime(uint32_t ms) { minTimeNs = (uint64_t) ms * 1000000; }
+		void setFilter(const char * f) { filter = f; }
+
+		template<typename Fn>
+		void run(const char * group, const char * name, Fn fn) {
+			if (!selected(group, name)) return;
+
+			fn();  // Warm up
+
+			uint64_t iterations = 1;
+			uint64_t elapsed = 0;
+			uint64_t simulated = 0;
+
+			for (;;) {
+				const uint64_t simStart = NXC_Host::simulatedTime();
+				const uint64_t start = NXC_Host::nanos();
+				for (uint64_t i = 0; i < iterations; i++) {
+					fn();
+				}
+				elapsed = NXC_Host::nanos() - start;
+				simulated = NXC_Host::simulatedTime() - simStart;
+
+				if (elapsed >= minTimeNs || iterations >= (1ULL << 40)) break;
+				iterations *= 2;
+			}
+
+			report(group, name, iterations, (double) elapsed / iterations, (double) simulated / iterations);
+		}
+
+		void header();
+
+	private:
+		bool selected(const char * group, const char * name) const;
+		void report(const char * group, const char * name, uint64_t iterations, double nsPerOp, double simUsPerOp);
+
+		FILE * out;
+		Format format = Format::JSON;
+		uint64_t minTimeNs = 20 * 1000000ULL;
+		const char * filter = nullptr;
+	};
+}
+
+#endif
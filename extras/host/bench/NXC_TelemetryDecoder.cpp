@@ -0,0 +1,123 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_TelemetryDecoder.h"
+
+namespace Telemetry = NintendoExtensionCtrl::Telemetry;
+
+namespace NXC_Bench {
+	boolean TelemetryDecoder::feed(uint8_t c, Frame & out) {
+		if (c != 0x00) {
+			if (length < sizeof(buffer)) buffer[length++] = c;
+			else overflow = true;
+			return false;
+		}
+
+		// End of frame
+		boolean complete = false;
+		if (length != 0) {
+			uint8_t record[Telemetry::MaxFrameSize];
+			const uint8_t size = overflow ? 0 : Telemetry::decode(buffer, length, record);
+
+			if (size != 0 && parse(record, size, out)) {
+				good++;
+				complete = true;
+			}
+		}
+
+		length = 0;
+		overflow = false;
+		return complete;
+	}
+
+	boolean TelemetryDecoder::parse(const uint8_t * record, uint8_t size, Frame & out) {
+		if (size < Telemetry::HeaderSize) {
+			bad++;
+			return false;
+		}
+
+		const uint8_t port = record[0] & Telemetry::PortMask;
+		const uint8_t dataSize = record[6];
+		const boolean keyFrame = record[0] & Telemetry::KeyFrame;
+		const uint8_t sequence = record[0] >> Telemetry::SequenceShift;
+
+		if (dataSize == 0 || dataSize > Telemetry::MaxDataSize) {
+			bad++;
+			return false;
+		}
+
+		PortState & state = ports[port];
+		const uint8_t * payload = record + Telemetry::HeaderSize;
+		const uint8_t payloadSize = size - Telemetry::HeaderSize;
+		uint8_t changed = 0;
+
+		if (keyFrame) {
+			if (payloadSize != dataSize) {
+				bad++;
+				return false;
+			}
+			state.type = (ExtensionType) record[1];
+			state.size = dataSize;
+			memcpy(state.data, payload, dataSize);
+			changed = dataSize;
+		}
+		else {
+			const uint8_t maskSize = (dataSize + 7) / 8;
+			if (payloadSize < maskSize) {
+				bad++;
+				return false;
+			}
+			if (state.size != dataSize || state.type != (ExtensionType) record[1] || state.sequence != sequence) {
+				state.size = 0;  // Wait for the next key frame
+				unsynced++;
+				return false;
+			}
+
+			for (uint8_t i = 0; i < dataSize; i++) {
+				if (payload[i >> 3] & (1 << (i & 7))) changed++;
+			}
+			if (maskSize + changed != payloadSize) {
+				bad++;  // Mask doesn't match the bytes sent
+				return false;
+			}
+
+			const uint8_t * values = payload + maskSize;
+			for (uint8_t i = 0; i < dataSize; i++) {
+				if (payload[i >> 3] & (1 << (i & 7))) {
+					state.data[i] = *values++;
+				}
+			}
+		}
+
+		state.sequence = (sequence + 1) & (0xFF >> Telemetry::SequenceShift);
+
+		out.port = port;
+		out.type = state.type;
+		out.timestamp = (uint32_t) record[2] | ((uint32_t) record[3] << 8)
+			| ((uint32_t) record[4] << 16) | ((uint32_t) record[5] << 24);
+		out.keyFrame = keyFrame;
+		out.changed = changed;
+		out.size = state.size;
+		memcpy(out.data, state.data, state.size);
+		return true;
+	}
+}
@@ -0,0 +1,74 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_TelemetryDecoder_h
+#define NXC_TelemetryDecoder_h
+
+#include <Arduino.h>
+#include "utility/NXC_Telemetry.h"
+
+namespace NXC_Bench {
+	// Reads the library's binary telemetry stream one byte at a time, and
+	// rebuilds each port's full control data from the key and delta frames.
+	// Delta frames for a port with no key frame yet, or after a gap in the
+	// port's sequence numbers, are dropped until the next key frame.
+	class TelemetryDecoder {
+	public:
+		struct Frame {
+			uint8_t port;
+			ExtensionType type;
+			uint32_t timestamp;  // Microseconds, from the sender
+			boolean keyFrame;
+			uint8_t changed;     // Bytes carried by a delta frame
+			uint8_t size;
+			uint8_t data[NintendoExtensionCtrl::Telemetry::MaxDataSize];
+		};
+
+		boolean feed(uint8_t c, Frame & out);  // 'true' when a frame is complete
+
+		uint32_t frames() const { return good; }
+		uint32_t badFrames() const { return bad; }        // Malformed or oversized
+		uint32_t unsyncedFrames() const { return unsynced; }  // Deltas dropped while out of sync
+
+	private:
+		boolean parse(const uint8_t * record, uint8_t size, Frame & out);
+
+		struct PortState {
+			ExtensionType type;
+			uint8_t size;  // 0 until a key frame
+			uint8_t sequence;  // Expected in the next frame
+			uint8_t data[NintendoExtensionCtrl::Telemetry::MaxDataSize];
+		};
+
+		PortState ports[NintendoExtensionCtrl::Telemetry::MaxPorts] = {};
+
+		uint8_t buffer[NintendoExtensionCtrl::Telemetry::MaxFrameSize];
+		uint8_t length = 0;
+		boolean overflow = false;
+
+		uint32_t good = 0;
+		uint32_t bad = 0;
+		uint32_t unsynced = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_TraceExport.h"
+
+using NintendoExtensionCtrl::TracePoint;
+using NintendoExtensionCtrl::TraceRecord;
+
+namespace NXC_Bench {
+	void ChromeTraceWriter::namePort(const void * id, const char * name) {
+		Port * p = port(id);
+		if (p != nullptr) {
+			p->name = name;
+		}
+	}
+
+	ChromeTraceWriter::Port * ChromeTraceWriter::port(const void * id) {
+		for (uint8_t i = 0; i < numPorts; i++) {
+			if (ports[i].id == id) return &ports[i];
+		}
+		if (numPorts == MaxPorts) return nullptr;
+
+		Port & p = ports[numPorts++];
+		p = Port();
+		p.id = id;
+		return &p;
+	}
+
+	void ChromeTraceWriter::begin() {
+		fputs("{\"traceEvents\":[\n", out);
+		events = 0;
+		for (uint8_t i = 0; i < numPorts; i++) {
+			ports[i].depth = 0;
+		}
+	}
+
+	void ChromeTraceWriter::event(const Port & p, uint8_t tid, TracePoint point, char phase, uint32_t time) {
+		fprintf(out, "%s{\"name\":\"%s\",\"cat\":\"nxc\",\"ph\":\"%c\",\"ts\":%u,\"pid\":1,\"tid\":%u}",
+			events ? ",\n" : "", NintendoExtensionCtrl::tracePointName(point), phase, time, tid);
+		events++;
+	}
+
+	void ChromeTraceWriter::write(const TraceRecord & r) {
+		Port * p = port(r.port != nullptr ? r.port : r.bus);  // Bus phases outside an update go on the bus' track
+		if (p == nullptr) return;
+		const uint8_t tid = (uint8_t) (p - ports);
+
+		p->lastTime = r.time;
+
+		if (r.begin) {
+			if (p->depth == MaxDepth) return;
+			p->open[p->depth++] = r.point;
+			event(*p, tid, r.point, 'B', r.time);
+		}
+		else if (p->depth != 0 && p->open[p->depth - 1] == r.point) {
+			p->depth--;
+			event(*p, tid, r.point, 'E', r.time);
+		}
+		// Otherwise the begin was overwritten, skip it
+	}
+
+	void ChromeTraceWriter::end(uint32_t dropped) {
+		for (uint8_t i = 0; i < numPorts; i++) {
+			Port & p = ports[i];
+			while (p.depth != 0) {
+				p.depth--;
+				event(p, i, p.open[p.depth], 'E', p.lastTime);
+			}
+
+			fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+				events ? ",\n" : "", i);
+			if (p.name != nullptr) fputs(p.name, out);
+			else fprintf(out, "port %u", i);
+			fputs("\"}}", out);
+			events++;
+		}
+
+		fprintf(out, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_records\":%u}}\n", dropped);
+	}
+}
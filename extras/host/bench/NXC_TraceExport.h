@@ -0,0 +1,81 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_TraceExport_h
+#define NXC_TraceExport_h
+
+#include <Arduino.h>
+#include "internal/NXC_Trace.h"
+
+namespace NXC_Bench {
+	// Writes trace records as Chrome trace event JSON, which loads in
+	// chrome://tracing and ui.perfetto.dev. Each port (ExtensionData) is its own
+	// thread in the trace. When the ring buffer has wrapped, the oldest records
+	// may be ends with no matching begin; those are skipped, and any phases
+	// still open at the end are closed at the port's last timestamp.
+	class ChromeTraceWriter {
+	public:
+		static const uint8_t MaxPorts = 16;
+		static const uint8_t MaxDepth = 8;
+
+		ChromeTraceWriter(FILE * output) : out(output) {}
+
+		void namePort(const void * port, const char * name);
+
+		void begin();
+		void write(const NintendoExtensionCtrl::TraceRecord & r);
+		void end(uint32_t dropped = 0);  // Records lost to the ring buffer wrapping
+
+		uint32_t eventCount() const { return events; }
+
+	#if NXC_ENABLE_TRACE
+		// Writes the library's trace buffer, oldest first
+		void writeBuffer() {
+			begin();
+			NintendoExtensionCtrl::TraceRecord r;
+			for (uint16_t i = 0; NintendoExtensionCtrl::Trace::get(i, r); i++) {
+				write(r);
+			}
+			end(NintendoExtensionCtrl::Trace::total() - NintendoExtensionCtrl::Trace::available());
+		}
+	#endif
+
+	private:
+		struct Port {
+			const void * id;
+			const char * name;
+			uint32_t lastTime;
+			uint8_t depth;
+			NintendoExtensionCtrl::TracePoint open[MaxDepth];
+		};
+
+		Port * port(const void * id);  // nullptr if out of slots
+		void event(const Port & p, uint8_t tid, NintendoExtensionCtrl::TracePoint point, char phase, uint32_t time);
+
+		FILE * out;
+		Port ports[MaxPorts] = {};
+		uint8_t numPorts = 0;
+		uint32_t events = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,215 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Multi-bus polling service demo.
+// Usage: nxc_pollservice [--buses n] [--ports n] [--rate hz] [--seconds s]
+//                        [--slow-bus us] [--pin] [--fifo priority]
+//
+// Starts one PollThread per bus, each polling its ports (simulated Classic
+// Controllers) at a fixed rate, and drains their frame queues from the main
+// thread. '--slow-bus' makes every transaction on bus 0 take that much real
+// time, to show that a slow bus only holds up its own thread. Writes one
+// JSON line per poll thread with its tick rate, missed ticks and wakeup
+// jitter, then one line for the consumer.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_PollService.h"
+#include "NXC_SimController.h"
+
+#include <memory>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using NXC_Host::FrameQueue;
+using NXC_Host::PolledFrame;
+using NXC_Host::PollThread;
+using NXC_Host::SimulatedController;
+
+// Bus wrapper that takes real time for every transaction
+class SlowBus : public NXC_Host::I2CBus {
+public:
+	SlowBus(I2CBus & target, uint32_t us) : bus(target), delayUs(us) {}
+
+	uint8_t write(uint8_t addr, const uint8_t * data, size_t length) override {
+		wait();
+		return bus.write(addr, data, length);
+	}
+
+	size_t read(uint8_t addr, uint8_t * data, size_t length) override {
+		wait();
+		return bus.read(addr, data, length);
+	}
+
+private:
+	void wait() {
+		if (delayUs == 0) return;
+		struct timespec ts = { 0, (long) delayUs * 1000 };
+		nanosleep(&ts, nullptr);
+	}
+
+	I2CBus & bus;
+	uint32_t delayUs;
+};
+
+// Everything behind one port. Extension controllers all sit at 0x52, so on
+// real hardware the ports on a bus would be behind a mux; here each port
+// gets a simulated bus of its own.
+struct SimPort {
+	SimPort(uint32_t slowUs) :
+		slow(bus, slowUs), wire(slow), controller(wire)
+	{
+		bus.attach(SimulatedController::Address, sim);
+	}
+
+	NXC_Host::SimulatedBus bus;
+	SimulatedController sim;
+	SlowBus slow;
+	TwoWire wire;
+	ClassicController controller;
+};
+
+int main(int argc, char * argv[]) {
+	uint32_t buses = 4;
+	uint32_t portsPerBus = 4;
+	uint32_t rate = 1000;
+	double seconds = 2.0;
+	uint32_t slowUs = 0;
+	bool pin = false;
+	int fifo = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--buses") == 0 && i + 1 < argc) {
+			buses = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--ports") == 0 && i + 1 < argc) {
+			portsPerBus = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+			rate = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+			seconds = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--slow-bus") == 0 && i + 1 < argc) {
+			slowUs = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--pin") == 0) {
+			pin = true;
+		}
+		else if (strcmp(argv[i], "--fifo") == 0 && i + 1 < argc) {
+			fifo = atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--buses n] [--ports n] [--rate hz] [--seconds s] "
+				"[--slow-bus us] [--pin] [--fifo priority]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (buses < 1 || buses > 32 || portsPerBus < 1 || portsPerBus > PollThread::MaxPorts) {
+		fprintf(stderr, "Between 1 and 32 buses, and 1 to %u ports per bus\n", PollThread::MaxPorts);
+		return 1;
+	}
+
+	Serial.mute(true);
+
+	std::vector<std::unique_ptr<SimPort>> ports;
+	std::vector<std::unique_ptr<PollThread>> threads;
+	static FrameQueue queues[32];  // Static, for the queue's cache line alignment
+	const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+	for (uint32_t b = 0; b < buses; b++) {
+		threads.emplace_back(new PollThread((uint8_t) b, rate));
+		PollThread & t = *threads.back();
+		t.addConsumer(queues[b]);
+		if (pin) t.setAffinity((int) (b % (cpus > 0 ? cpus : 1)));
+		if (fifo > 0) t.setFifoPriority(fifo);
+
+		for (uint32_t p = 0; p < portsPerBus; p++) {
+			ports.emplace_back(new SimPort(b == 0 ? slowUs : 0));
+			ports.back()->controller.begin();
+			t.addPort(ports.back()->controller);
+		}
+	}
+
+	for (std::unique_ptr<PollThread> & t : threads) {
+		if (!t->start()) {
+			fprintf(stderr, "Could not start poll thread %u\n", t->getID());
+			return 1;
+		}
+	}
+
+	// Consumer: drain every queue once a millisecond
+	std::vector<uint64_t> framesPerPort(buses * portsPerBus, 0);
+	uint64_t frames = 0;
+	uint64_t failed = 0;
+	uint64_t maxAgeNs = 0;
+
+	const uint64_t start = NXC_Host::nanos();
+	const uint64_t end = start + (uint64_t) (seconds * 1e9);
+
+	while (NXC_Host::nanos() < end) {
+		for (uint32_t b = 0; b < buses; b++) {
+			PolledFrame f;
+			while (queues[b].pop(f)) {
+				const uint64_t age = NXC_Host::nanos() - f.time;
+				if (age > maxAgeNs) maxAgeNs = age;
+				if (!f.ok) failed++;
+				framesPerPort[f.bus * portsPerBus + f.port]++;
+				frames++;
+			}
+		}
+		usleep(1000);
+	}
+
+	for (std::unique_ptr<PollThread> & t : threads) {
+		t->stop();
+	}
+	const double elapsed = (NXC_Host::nanos() - start) / 1e9;
+
+	for (std::unique_ptr<PollThread> & t : threads) {
+		const PollThread::Stats s = t->stats();
+		printf("{\"bus\":%u,\"ports\":%u,\"rate_hz\":%u,\"ticks\":%llu,\"ticks_per_s\":%.1f,\"missed_ticks\":%llu,"
+			"\"late_mean_us\":%.1f,\"late_p99_us\":%llu,\"late_max_us\":%.1f,\"work_max_us\":%.1f,"
+			"\"update_failures\":%llu,\"frames_dropped\":%llu,\"sched_error\":\"%s\"}\n",
+			t->getID(), portsPerBus, t->getRate(), (unsigned long long) s.ticks, s.ticks / elapsed,
+			(unsigned long long) s.missedTicks,
+			s.ticks ? s.lateSumNs / 1000.0 / s.ticks : 0.0,
+			(unsigned long long) PollThread::latePercentileUs(s, 0.99), s.lateMaxNs / 1000.0, s.workMaxNs / 1000.0,
+			(unsigned long long) s.updateFailures, (unsigned long long) s.framesDropped,
+			t->schedulingError() ? strerror(t->schedulingError()) : "");
+	}
+
+	uint64_t minPort = UINT64_MAX, maxPort = 0;
+	for (uint64_t n : framesPerPort) {
+		if (n < minPort) minPort = n;
+		if (n > maxPort) maxPort = n;
+	}
+
+	printf("{\"consumer\":true,\"frames\":%llu,\"failed\":%llu,\"min_port_hz\":%.1f,\"max_port_hz\":%.1f,\"max_age_us\":%.1f}\n",
+		(unsigned long long) frames, (unsigned long long) failed,
+		minPort / elapsed, maxPort / elapsed, maxAgeNs / 1000.0);
+	return 0;
+}
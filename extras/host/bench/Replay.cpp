@@ -0,0 +1,334 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Capture recording and replay.
+// Usage: nxc_replay record [--type name] [--frames n] [--size n] [--seed n] --out file
+//        nxc_replay play file [--realtime] [--loops n]
+//
+// 'record' polls a simulated controller whose inputs follow a seeded random
+// walk, and writes a capture with CaptureWriter, the same as a board would.
+// Types are nunchuk, classic, guitar, drums and dj.
+//
+// 'play' memory-maps a capture and replays it through ReplayController, with
+// a controller of the captured type decoding every frame with all of its
+// accessors. It writes one JSON line: frames, update failures, host time per
+// frame, throughput, and a digest of every decoded value, which only changes
+// if decoding behavior does.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_Bench.h"
+#include "NXC_Replay.h"
+
+#include <time.h>
+
+using NXC_Bench::FilePrint;
+using NXC_Host::CaptureFile;
+using NXC_Host::ReplayController;
+using NXC_Host::SimulatedController;
+
+// FNV-1a over every decoded value
+class Digest {
+public:
+	void add(uint32_t v) {
+		for (int i = 0; i < 4; i++) {
+			hash ^= (uint8_t) (v >> (i * 8));
+			hash *= 0x100000001B3ULL;
+		}
+	}
+	uint64_t value() const { return hash; }
+private:
+	uint64_t hash = 0xCBF29CE484222325ULL;
+};
+
+static void decode(const Nunchuk::Shared & c, Digest & d) {
+	d.add(c.joyX()); d.add(c.joyY());
+	d.add(c.accelX()); d.add(c.accelY()); d.add(c.accelZ());
+	d.add(c.buttonC()); d.add(c.buttonZ());
+}
+
+static void decode(const ClassicController::Shared & c, Digest & d) {
+	d.add(c.leftJoyX()); d.add(c.leftJoyY()); d.add(c.rightJoyX()); d.add(c.rightJoyY());
+	d.add(c.dpadUp()); d.add(c.dpadDown()); d.add(c.dpadLeft()); d.add(c.dpadRight());
+	d.add(c.buttonA()); d.add(c.buttonB()); d.add(c.buttonX()); d.add(c.buttonY());
+	d.add(c.triggerL()); d.add(c.triggerR()); d.add(c.buttonL()); d.add(c.buttonR());
+	d.add(c.buttonZL()); d.add(c.buttonZR());
+	d.add(c.buttonStart()); d.add(c.buttonSelect()); d.add(c.buttonHome());
+	d.add(c.isNESKnockoff());
+}
+
+static void decode(GuitarController::Shared & c, Digest & d) {
+	d.add(c.joyX()); d.add(c.joyY());
+	d.add(c.strumMask()); d.add(c.fretMask());
+	d.add(c.whammyBar()); d.add(c.touchbar()); d.add(c.touchMask());
+	d.add(c.buttonPlus()); d.add(c.buttonMinus());
+}
+
+static void decode(const DrumController::Shared & c, Digest & d) {
+	d.add(c.joyX()); d.add(c.joyY());
+	d.add(c.drumRed()); d.add(c.drumBlue()); d.add(c.drumGreen());
+	d.add(c.cymbalYellow()); d.add(c.cymbalOrange()); d.add(c.bassPedal());
+	d.add(c.buttonPlus()); d.add(c.buttonMinus());
+	d.add(c.velocityAvailable()); d.add((uint32_t) c.velocityID()); d.add(c.velocity());
+}
+
+static void decode(DJTurntableController::Shared & c, Digest & d) {
+	d.add((uint32_t) c.turntable()); d.add(c.buttonGreen()); d.add(c.buttonRed()); d.add(c.buttonBlue());
+	d.add(c.effectDial()); d.add((uint32_t) c.crossfadeSlider()); d.add(c.buttonEuphoria());
+	d.add(c.joyX()); d.add(c.joyY());
+	d.add(c.buttonPlus()); d.add(c.buttonMinus());
+}
+
+struct TypeName {
+	const char * name;
+	ExtensionType type;
+};
+
+static const TypeName TypeNames[] = {
+	{ "nunchuk", ExtensionType::Nunchuk },
+	{ "classic", ExtensionType::ClassicController },
+	{ "guitar", ExtensionType::GuitarController },
+	{ "drums", ExtensionType::DrumController },
+	{ "dj", ExtensionType::DJTurntableController },
+};
+
+static const char * typeName(ExtensionType type) {
+	for (const TypeName & t : TypeNames) {
+		if (t.type == type) return t.name;
+	}
+	return "unknown";
+}
+
+static uint64_t hostNanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int record(ExtensionType type, uint64_t frames, uint8_t size, uint32_t seed, const char * path) {
+	FILE * out = fopen(path, "wb");
+	if (out == nullptr) {
+		fprintf(stderr, "Could not open '%s'\n", path);
+		return 1;
+	}
+
+	SimulatedController sim(type);
+	NXC_Host::defaultBus().attach(SimulatedController::Address, sim);
+
+	ExtensionPort port;
+	port.begin();
+	port.setRequestSize(size);
+	if (!port.connect()) {
+		fprintf(stderr, "Could not connect to the simulated controller\n");
+		return 1;
+	}
+
+	FilePrint output(out);
+	NintendoExtensionCtrl::CaptureWriter writer(output);
+	if (!writer.begin(port)) {
+		fprintf(stderr, "Could not write the capture header\n");
+		return 1;
+	}
+
+	uint8_t data[6];
+	memcpy(data, sim.registerData(), sizeof(data));
+	uint32_t state = seed ? seed : 1;
+
+	for (uint64_t i = 0; i < frames; i++) {
+		// xorshift32 random walk: nudge an axis byte, or flip a button bit
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		const uint8_t index = state % 6;
+		if (index < 4) {
+			data[index] += (uint8_t) ((state >> 8) % 5) - 2;
+		}
+		else if ((state >> 8) % 8 == 0) {
+			data[index] ^= 1 << ((state >> 11) % 8);
+		}
+		if (!NintendoExtensionCtrl::verifyData(data, sizeof(data))) {
+			data[0] ^= 0x01;  // Keep the frame valid
+		}
+
+		sim.setControlData(data, sizeof(data));
+		if (!port.update() || !writer.record(port)) {
+			fprintf(stderr, "Recording failed at frame %llu\n", (unsigned long long) i);
+			return 1;
+		}
+	}
+
+	fclose(out);
+	fprintf(stderr, "%u records (%s, %u bytes each) written to '%s'\n",
+		writer.recordsWritten(), typeName(type), size, path);
+	return 0;
+}
+
+template<class Controller>
+static void playFrames(Controller & controller, ReplayController & replay, uint64_t frames, bool realTime, uint64_t & played, uint64_t & failures, Digest & digest) {
+	while (realTime ? !replay.finished() : played < frames) {
+		if (!controller.update()) {
+			failures++;
+		}
+		decode(controller, digest);
+		played++;
+	}
+}
+
+static int play(const char * path, bool realTime, uint32_t loops) {
+	CaptureFile capture;
+	if (!capture.open(path)) {
+		fprintf(stderr, "Could not open capture '%s': %s\n", path, capture.error());
+		return 1;
+	}
+
+	ReplayController replay(capture, realTime ? ReplayController::Mode::RealTime : ReplayController::Mode::FullSpeed);
+	replay.setLoop(loops > 1 && !realTime);
+	NXC_Host::defaultBus().attach(SimulatedController::Address, replay);
+	NXC_Host::setRealtime(realTime);  // Real bus waits when replaying in real time
+
+	ExtensionPort port;
+	port.begin();
+	port.setRequestSize(capture.requestSize());
+	if (!port.connect()) {
+		fprintf(stderr, "Could not connect to the replayed controller\n");
+		return 1;
+	}
+	replay.rewind();  // Connecting read a frame
+
+	const uint64_t frames = capture.records() * (loops ? loops : 1);
+	uint64_t played = 0;
+	uint64_t failures = 0;
+	Digest digest;
+
+	ExtensionController::ExtensionData & data = port.getExtensionData();
+	const uint64_t start = hostNanos();
+
+	switch (capture.type()) {
+		case(ExtensionType::Nunchuk): {
+			Nunchuk::Shared c(data);
+			playFrames(c, replay, frames, realTime, played, failures, digest);
+			break;
+		}
+		case(ExtensionType::ClassicController): {
+			ClassicController::Shared c(data);
+			playFrames(c, replay, frames, realTime, played, failures, digest);
+			break;
+		}
+		case(ExtensionType::GuitarController): {
+			GuitarController::Shared c(data);
+			playFrames(c, replay, frames, realTime, played, failures, digest);
+			break;
+		}
+		case(ExtensionType::DrumController): {
+			DrumController::Shared c(data);
+			playFrames(c, replay, frames, realTime, played, failures, digest);
+			break;
+		}
+		case(ExtensionType::DJTurntableController): {
+			DJTurntableController::Shared c(data);
+			playFrames(c, replay, frames, realTime, played, failures, digest);
+			break;
+		}
+		default:
+			fprintf(stderr, "Unsupported controller type in capture\n");
+			return 1;
+	}
+
+	const double elapsed = (double) (hostNanos() - start);
+
+	printf("{\"capture\":\"%s\",\"type\":\"%s\",\"request_size\":%u,\"records\":%llu,\"mode\":\"%s\","
+		"\"frames\":%llu,\"failures\":%llu,\"ns_per_frame\":%.3f,\"mb_per_s\":%.1f,\"digest\":\"%016llx\"}\n",
+		path, typeName(capture.type()), capture.requestSize(), (unsigned long long) capture.records(),
+		realTime ? "realtime" : "full", (unsigned long long) played, (unsigned long long) failures,
+		played ? elapsed / played : 0.0,
+		played ? (played * (double) capture.header().stride) / elapsed * 1000.0 : 0.0,
+		(unsigned long long) digest.value());
+	return 0;
+}
+
+static int usage(const char * name) {
+	fprintf(stderr, "Usage: %s record [--type name] [--frames n] [--size n] [--seed n] --out file\n"
+	                "       %s play file [--realtime] [--loops n]\n", name, name);
+	return 1;
+}
+
+int main(int argc, char * argv[]) {
+	Serial.mute(true);
+
+	if (argc >= 2 && strcmp(argv[1], "record") == 0) {
+		ExtensionType type = ExtensionType::ClassicController;
+		uint64_t frames = 100000;
+		uint8_t size = 6;
+		uint32_t seed = 1;
+		const char * path = nullptr;
+
+		for (int i = 2; i < argc; i++) {
+			if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+				const char * name = argv[++i];
+				type = ExtensionType::NoController;
+				for (const TypeName & t : TypeNames) {
+					if (strcmp(t.name, name) == 0) type = t.type;
+				}
+				if (type == ExtensionType::NoController) return usage(argv[0]);
+			}
+			else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+				frames = strtoull(argv[++i], nullptr, 10);
+			}
+			else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+				size = (uint8_t) atoi(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+				seed = (uint32_t) strtoul(argv[++i], nullptr, 10);
+			}
+			else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+				path = argv[++i];
+			}
+			else {
+				return usage(argv[0]);
+			}
+		}
+		if (path == nullptr || size < ExtensionController::MinRequestSize || size > ExtensionController::MaxRequestSize) {
+			return usage(argv[0]);
+		}
+		return record(type, frames, size, seed, path);
+	}
+	else if (argc >= 3 && strcmp(argv[1], "play") == 0) {
+		bool realTime = false;
+		uint32_t loops = 1;
+
+		for (int i = 3; i < argc; i++) {
+			if (strcmp(argv[i], "--realtime") == 0) {
+				realTime = true;
+			}
+			else if (strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+				loops = (uint32_t) atoi(argv[++i]);
+			}
+			else {
+				return usage(argv[0]);
+			}
+		}
+		return play(argv[2], realTime, loops);
+	}
+
+	return usage(argv[0]);
+}
@@ -0,0 +1,203 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Update scheduler session on simulated buses, against updating every port
+// on every loop. Usage: nxc_scheduler [--seconds s] [--clock hz] [--budget us] [--work us]
+//
+// Three ports share one simulated timeline: a DJ turntable wanting 1 kHz, a
+// drum set wanting 500 Hz, and a Nunchuk used as a menu stick at 100 Hz.
+// The sketch's own work takes '--work' microseconds per loop, with a 3 ms
+// spike every 50 loops. Writes one JSON line per port and mode, with the
+// rate achieved and the gaps between reads, then one summary line per mode.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_SimController.h"
+#include "NXC_TimedBus.h"
+
+#include <string.h>
+
+using NXC_Host::SimulatedController;
+using NXC_Host::TimedBus;
+
+// Records the simulated time of every control data read
+class StampBus : public NXC_Host::I2CBus {
+public:
+	StampBus(NXC_Host::I2CBus & target) : bus(target) {}
+
+	void setClock(uint32_t hz) override { bus.setClock(hz); }
+	uint8_t write(uint8_t addr, const uint8_t * data, size_t length) override { return bus.write(addr, data, length); }
+
+	size_t read(uint8_t addr, uint8_t * data, size_t length) override {
+		const size_t n = bus.read(addr, data, length);
+		const uint64_t now = NXC_Host::simulatedTime();
+		if (reads > 0) {
+			const uint64_t gap = now - last;
+			if (gap > maxGap) maxGap = gap;
+			if (gap >= 2 * interval) late++;  // At least one period went by without a read
+		}
+		last = now;
+		reads++;
+		return n;
+	}
+
+	void reset(uint32_t intervalUs) {
+		interval = intervalUs;
+		reads = 0;
+		late = 0;
+		maxGap = 0;
+	}
+
+	uint32_t interval = 0;
+	uint32_t reads = 0;
+	uint32_t late = 0;
+	uint64_t maxGap = 0;
+	uint64_t last = 0;
+
+private:
+	NXC_Host::I2CBus & bus;
+};
+
+struct Channel {
+	const char * name;
+	ExtensionType type;
+	uint16_t rate;
+	uint8_t priority;
+
+	NXC_Host::SimulatedBus sim;
+	SimulatedController controller;
+	TimedBus timed;
+	StampBus stamp;
+	TwoWire wire;
+	ExtensionPort port;
+
+	Channel(const char * n, ExtensionType t, uint16_t r, uint8_t p) :
+		name(n), type(t), rate(r), priority(p),
+		timed(sim), stamp(timed), wire(stamp), port(wire) {}
+};
+
+static Channel channels[] = {
+	{ "dj", ExtensionType::DJTurntableController, 1000, 2 },
+	{ "drums", ExtensionType::DrumController, 500, 1 },
+	{ "nunchuk", ExtensionType::Nunchuk, 100, 0 },
+};
+
+static uint32_t workUs = 300;
+
+static void loopWork(uint32_t loop) {
+	delayMicroseconds(workUs);
+	if (loop % 50 == 49) delay(3);  // Display refresh, or similar
+}
+
+static void report(const char * mode, uint64_t startTime, uint32_t loops, const NintendoExtensionCtrl::UpdateScheduler * scheduler) {
+	const double seconds = (NXC_Host::simulatedTime() - startTime) / 1000000.0;
+	uint32_t totalLate = 0;
+
+	for (uint8_t i = 0; i < sizeof(channels) / sizeof(Channel); i++) {
+		const Channel & c = channels[i];
+		printf("{\"mode\":\"%s\",\"port\":\"%s\",\"target_hz\":%u,\"rate_hz\":%.1f,\"max_gap_us\":%llu,\"late_gaps\":%u",
+			mode, c.name, c.rate, c.stamp.reads / seconds, (unsigned long long) c.stamp.maxGap, c.stamp.late);
+		if (scheduler != nullptr) {
+			const NintendoExtensionCtrl::UpdateScheduler::PortStatus & s = scheduler->getStatus(i);
+			printf(",\"missed\":%u,\"max_late_us\":%u,\"failures\":%u", s.missed, s.maxLate, s.failures);
+		}
+		printf("}\n");
+		totalLate += c.stamp.late;
+	}
+
+	printf("{\"mode\":\"%s\",\"summary\":true,\"seconds\":%.2f,\"loops_per_s\":%.1f,\"late_gaps\":%u",
+		mode, seconds, loops / seconds, totalLate);
+	if (scheduler != nullptr) {
+		printf(",\"missed\":%u,\"bus_load_pct\":%u", scheduler->missedDeadlines(), scheduler->busLoad());
+	}
+	printf("}\n");
+}
+
+int main(int argc, char * argv[]) {
+	uint32_t seconds = 10;
+	uint32_t clock = 400000;
+	uint32_t budget = 800;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+			seconds = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--clock") == 0 && i + 1 < argc) {
+			clock = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+			budget = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--work") == 0 && i + 1 < argc) {
+			workUs = (uint32_t) atoi(argv[++i]);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--seconds s] [--clock hz] [--budget us] [--work us]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);
+
+	for (Channel & c : channels) {
+		c.controller.setType(c.type);
+		c.controller.reset();
+		c.sim.attach(SimulatedController::Address, c.controller);
+		c.port.begin();
+		c.wire.setClock(clock);
+		if (!c.port.connect()) {
+			fprintf(stderr, "Could not connect to simulated %s\n", c.name);
+			return 1;
+		}
+	}
+
+	const uint64_t duration = (uint64_t) seconds * 1000000;
+
+	// Every port on every loop
+	for (Channel & c : channels) c.stamp.reset(1000000 / c.rate);
+	uint64_t start = NXC_Host::simulatedTime();
+	uint32_t loops = 0;
+	while (NXC_Host::simulatedTime() - start < duration) {
+		for (Channel & c : channels) c.port.update();
+		loopWork(loops++);
+	}
+	report("every_loop", start, loops, nullptr);
+
+	// Scheduled
+	NintendoExtensionCtrl::UpdateSchedulerTable<3> scheduler;
+	scheduler.setClock(clock);
+	scheduler.setBudget(budget);
+	for (Channel & c : channels) {
+		scheduler.add(c.port, c.rate, c.priority);
+		c.stamp.reset(1000000 / c.rate);
+	}
+
+	start = NXC_Host::simulatedTime();
+	loops = 0;
+	while (NXC_Host::simulatedTime() - start < duration) {
+		scheduler.run();
+		loopWork(loops++);
+	}
+	report("scheduled", start, loops, &scheduler);
+
+	return 0;
+}
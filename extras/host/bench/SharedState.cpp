@@ -0,0 +1,296 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Shared memory publication of controller state.
+// Usage: nxc_sharedstate stress [--seconds s]
+//        nxc_sharedstate publish [--name /nxc] [--ports n] [--rate hz] [--seconds s]
+//        nxc_sharedstate read [--name /nxc] [--slot n] [--seconds s]
+//
+// 'stress' forks a reader process against a writer that publishes to one
+// slot as fast as it can. Every frame is a pattern the reader can check, so
+// a torn read would show up as a mismatch. Each side writes one JSON line.
+//
+// 'publish' polls simulated Classic Controllers with changing inputs and
+// publishes them, and 'read' decodes a slot from another process with the
+// ClassicController's 'Shared' class, printing a JSON line when it changes.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_SharedState.h"
+#include "NXC_SimController.h"
+
+#include <memory>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using NXC_Host::SharedFrame;
+using NXC_Host::SharedPort;
+using NXC_Host::SharedStatePublisher;
+using NXC_Host::SharedStateReader;
+using NXC_Host::SimulatedController;
+
+static const uint8_t PatternSize = ExtensionController::MaxRequestSize;
+
+static void fillPattern(uint8_t * data, uint32_t n) {
+	for (uint8_t i = 0; i < PatternSize; i++) {
+		data[i] = (uint8_t) (n + i * 37);
+	}
+}
+
+static bool checkPattern(const uint8_t * data) {
+	for (uint8_t i = 1; i < PatternSize; i++) {
+		if (data[i] != (uint8_t) (data[0] + i * 37)) return false;
+	}
+	return true;
+}
+
+static uint64_t monotonicNs() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int stressReader(const char * name, double seconds) {
+	SharedStateReader reader;
+	const uint64_t giveUp = monotonicNs() + 1000000000ULL;
+	while (!reader.open(name)) {
+		if (monotonicNs() > giveUp) {
+			fprintf(stderr, "Reader could not open '%s': %s\n", name, strerror(reader.lastError()));
+			return 1;
+		}
+		usleep(1000);
+	}
+
+	SharedPort port;
+	ClassicController::Shared classic(port.getExtensionData());
+
+	uint64_t reads = 0, busy = 0, torn = 0, fresh = 0;
+	uint32_t sink = 0;
+	const uint64_t start = monotonicNs();
+	const uint64_t end = start + (uint64_t) (seconds * 1e9);
+
+	SharedFrame f;
+	while ((reads & 0xFF) != 0 || monotonicNs() < end) {
+		reads++;
+		if (!reader.read(0, f)) {
+			busy++;
+			continue;
+		}
+		if (f.size == PatternSize && !checkPattern(f.data)) {
+			torn++;
+		}
+		if (port.refresh(reader, 0)) {
+			fresh++;
+			sink += classic.leftJoyX() + classic.buttonA();  // Decoded from the mapped state
+		}
+	}
+
+	const double elapsed = (double) (monotonicNs() - start);
+	printf("{\"side\":\"reader\",\"pid\":%d,\"reads\":%llu,\"ns_per_read\":%.1f,\"new_frames\":%llu,"
+		"\"busy\":%llu,\"torn\":%llu,\"sink\":%u}\n",
+		(int) getpid(), (unsigned long long) reads, elapsed / reads, (unsigned long long) fresh,
+		(unsigned long long) busy, (unsigned long long) torn, sink);
+	return torn == 0 ? 0 : 1;
+}
+
+static int stress(double seconds) {
+	char name[32];
+	snprintf(name, sizeof(name), "/nxc_stress_%d", (int) getpid());
+
+	SharedStatePublisher pub;
+	if (!pub.create(name, 1)) {
+		fprintf(stderr, "Could not create '%s': %s\n", name, strerror(pub.lastError()));
+		return 1;
+	}
+
+	fflush(stdout);
+	const pid_t child = fork();
+	if (child < 0) {
+		perror("fork");
+		return 1;
+	}
+	if (child == 0) {
+		const int result = stressReader(name, seconds);
+		fflush(stdout);  // _exit() skips it
+		_exit(result);
+	}
+
+	uint8_t data[PatternSize];
+	uint64_t frames = 0;
+	const uint64_t start = monotonicNs();
+	const uint64_t end = start + (uint64_t) ((seconds + 0.1) * 1e9);  // Outlast the reader
+
+	while ((frames & 0xFF) != 0 || monotonicNs() < end) {
+		fillPattern(data, (uint32_t) frames);
+		pub.publish(0, ExtensionType::ClassicController, data, PatternSize, monotonicNs());
+		frames++;
+	}
+	const double elapsed = (double) (monotonicNs() - start);
+
+	int status = 0;
+	waitpid(child, &status, 0);
+
+	printf("{\"side\":\"writer\",\"pid\":%d,\"frames\":%llu,\"ns_per_publish\":%.1f}\n",
+		(int) getpid(), (unsigned long long) frames, elapsed / frames);
+	return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
+
+struct SimPort {
+	SimPort() : wire(bus), controller(wire) {
+		bus.attach(SimulatedController::Address, sim);
+	}
+
+	NXC_Host::SimulatedBus bus;
+	SimulatedController sim;
+	TwoWire wire;
+	ClassicController controller;
+};
+
+static int publish(const char * name, uint32_t ports, uint32_t rate, double seconds) {
+	SharedStatePublisher pub;
+	if (!pub.create(name, (uint8_t) ports)) {
+		fprintf(stderr, "Could not create '%s': %s\n", name, strerror(pub.lastError()));
+		return 1;
+	}
+
+	std::vector<std::unique_ptr<SimPort>> sims;
+	for (uint32_t i = 0; i < ports; i++) {
+		sims.emplace_back(new SimPort());
+		sims.back()->controller.begin();
+		sims.back()->controller.connect();
+	}
+
+	const uint64_t period = 1000000000ULL / (rate ? rate : 1);
+	const uint64_t end = monotonicNs() + (uint64_t) (seconds * 1e9);
+	uint64_t next = monotonicNs();
+	uint32_t tick = 0;
+
+	fprintf(stderr, "Publishing %u ports to '%s' at %u Hz\n", ports, name, rate);
+	while (monotonicNs() < end) {
+		for (uint32_t i = 0; i < ports; i++) {
+			SimPort & p = *sims[i];
+			p.sim.setControlData(0, (uint8_t) ((p.sim.registerData()[0] & 0xC0) | ((tick / 16 + i) & 0x3F)));  // Left stick X
+			p.sim.setControlData(5, (tick / 500) % 2 ? 0xEF : 0xFF);  // Button A, every half second at 1 kHz
+			p.controller.update();
+			pub.publish((uint8_t) i, p.controller);
+		}
+		tick++;
+
+		next += period;
+		struct timespec ts = { (time_t) (next / 1000000000ULL), (long) (next % 1000000000ULL) };
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+	}
+	return 0;
+}
+
+static int read(const char * name, uint8_t slot, double seconds) {
+	SharedStateReader reader;
+	if (!reader.open(name)) {
+		fprintf(stderr, "Could not open '%s': %s\n", name, strerror(reader.lastError()));
+		return 1;
+	}
+	if (slot >= reader.slots()) {
+		fprintf(stderr, "'%s' has %u slots\n", name, reader.slots());
+		return 1;
+	}
+
+	SharedPort port;
+	ClassicController::Shared classic(port.getExtensionData());
+	uint8_t lastX = 0xFF;
+	bool lastA = false;
+
+	const uint64_t end = monotonicNs() + (uint64_t) (seconds * 1e9);
+	while (monotonicNs() < end) {
+		if (port.refresh(reader, slot) && port.getType() == ExtensionType::ClassicController &&
+			(classic.leftJoyX() != lastX || classic.buttonA() != lastA))
+		{
+			lastX = classic.leftJoyX();
+			lastA = classic.buttonA();
+			printf("{\"publisher\":%u,\"slot\":%u,\"age_us\":%.1f,\"leftJoyX\":%u,\"buttonA\":%d}\n",
+				reader.publisherPID(), slot, (monotonicNs() - port.getTime()) / 1000.0, lastX, lastA);
+		}
+		usleep(1000);
+	}
+	return 0;
+}
+
+int main(int argc, char * argv[]) {
+	const char * usage =
+		"Usage: %s stress [--seconds s]\n"
+		"       %s publish [--name /nxc] [--ports n] [--rate hz] [--seconds s]\n"
+		"       %s read [--name /nxc] [--slot n] [--seconds s]\n";
+
+	if (argc < 2) {
+		fprintf(stderr, usage, argv[0], argv[0], argv[0]);
+		return 1;
+	}
+
+	const char * name = "/nxc";
+	uint32_t ports = 4;
+	uint32_t rate = 1000;
+	uint32_t slot = 0;
+	double seconds = 2.0;
+
+	for (int i = 2; i < argc; i++) {
+		if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+			name = argv[++i];
+		}
+		else if (strcmp(argv[i], "--ports") == 0 && i + 1 < argc) {
+			ports = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+			rate = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--slot") == 0 && i + 1 < argc) {
+			slot = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+			seconds = atof(argv[++i]);
+		}
+		else {
+			fprintf(stderr, usage, argv[0], argv[0], argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);
+
+	if (strcmp(argv[1], "stress") == 0) {
+		return stress(seconds);
+	}
+	else if (strcmp(argv[1], "publish") == 0) {
+		if (ports < 1 || ports > SharedStatePublisher::MaxSlots) {
+			fprintf(stderr, "Between 1 and %u ports\n", SharedStatePublisher::MaxSlots);
+			return 1;
+		}
+		return publish(name, ports, rate, seconds);
+	}
+	else if (strcmp(argv[1], "read") == 0) {
+		return read(name, (uint8_t) slot, seconds);
+	}
+
+	fprintf(stderr, usage, argv[0], argv[0], argv[0]);
+	return 1;
+}
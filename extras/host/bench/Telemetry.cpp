@@ -0,0 +1,160 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Binary telemetry capture and decoding.
+// Usage: nxc_telemetry capture [--frames n] [--out file]
+//        nxc_telemetry decode [file]
+//
+// 'capture' polls three simulated ports (Nunchuk, Classic Controller, Guitar)
+// with changing inputs and writes the telemetry stream, then prints the size
+// against printDebug() text to stderr. 'decode' reads a stream (from stdin by
+// default) and writes one JSON line per frame with the full control data.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_Bench.h"
+#include "NXC_SimController.h"
+#include "NXC_TelemetryDecoder.h"
+
+using NXC_Bench::FilePrint;
+using NXC_Host::SimulatedBus;
+using NXC_Host::SimulatedController;
+
+class CountingPrint : public Print {
+public:
+	size_t write(uint8_t) override { count++; return 1; }
+	size_t write(const uint8_t *, size_t size) override { count += size; return size; }
+	uint32_t count = 0;
+};
+
+struct SimPort {
+	SimulatedBus bus;
+	SimulatedController sim;
+	TwoWire wire;
+
+	SimPort(ExtensionType type) : sim(type), wire(bus) {
+		bus.attach(SimulatedController::Address, sim);
+	}
+};
+
+static int capture(uint32_t frames, FILE * out) {
+	SimPort port0(ExtensionType::Nunchuk);
+	SimPort port1(ExtensionType::ClassicController);
+	SimPort port2(ExtensionType::GuitarController);
+
+	ExtensionPort controllers[3] = { ExtensionPort(port0.wire), ExtensionPort(port1.wire), ExtensionPort(port2.wire) };
+	for (ExtensionPort & c : controllers) {
+		c.begin();
+		if (!c.connect()) {
+			fprintf(stderr, "Could not connect to the simulated controllers\n");
+			return 1;
+		}
+	}
+	controllers[1].setRequestSize(8);
+
+	FilePrint output(out);
+	NintendoExtensionCtrl::TelemetryStreamTable<3> telemetry(output);
+	CountingPrint text;
+
+	for (uint32_t i = 0; i < frames; i++) {
+		port0.sim.setControlData(0, (uint8_t) (128 + (i % 64) - 32));  // Joystick sweep
+		port1.sim.setControlData(4, (i / 10) % 2 ? 0xEF : 0xFF);         // Button held for 10 frames
+		if (i % 50 == 0) {
+			port2.sim.setControlData(5, (i / 50) % 2 ? 0xEE : 0xFF);     // Fret chord
+		}
+
+		for (uint8_t p = 0; p < 3; p++) {
+			controllers[p].update();
+			telemetry.send(p, controllers[p]);
+			controllers[p].printDebug(text);
+		}
+	}
+
+	const uint32_t records = telemetry.recordsSent();
+	const double binaryBytes = (double) telemetry.bytesSent() / records;
+	const double textBytes = (double) text.count / records;
+	const double uartBytesPerSec = 115200 / 10.0;  // 8N1
+
+	fprintf(stderr, "%u records, %u bytes\n", records, telemetry.bytesSent());
+	fprintf(stderr, "telemetry: %.2f bytes/record, %.0f records/s at 115200 baud\n", binaryBytes, uartBytesPerSec / binaryBytes);
+	fprintf(stderr, "printDebug: %.2f bytes/record, %.0f records/s at 115200 baud\n", textBytes, uartBytesPerSec / textBytes);
+	return 0;
+}
+
+static int decode(FILE * in) {
+	NXC_Bench::TelemetryDecoder decoder;
+	NXC_Bench::TelemetryDecoder::Frame frame;
+
+	int c;
+	while ((c = fgetc(in)) != EOF) {
+		if (!decoder.feed((uint8_t) c, frame)) continue;
+
+		printf("{\"port\":%u,\"type\":%u,\"timestamp_us\":%u,\"key\":%s,\"changed\":%u,\"data\":\"",
+			frame.port, (unsigned) frame.type, frame.timestamp, frame.keyFrame ? "true" : "false", frame.changed);
+		for (uint8_t i = 0; i < frame.size; i++) {
+			printf("%02X", frame.data[i]);
+		}
+		printf("\"}\n");
+	}
+
+	fprintf(stderr, "%u frames, %u bad, %u unsynced\n", decoder.frames(), decoder.badFrames(), decoder.unsyncedFrames());
+	return 0;
+}
+
+int main(int argc, char * argv[]) {
+	if (argc >= 2 && strcmp(argv[1], "capture") == 0) {
+		uint32_t frames = 1000;
+		FILE * out = stdout;
+
+		for (int i = 2; i < argc; i++) {
+			if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+				frames = (uint32_t) atoi(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc && (out = fopen(argv[++i], "wb")) != nullptr) {
+				continue;
+			}
+			else {
+				fprintf(stderr, "Usage: %s capture [--frames n] [--out file]\n", argv[0]);
+				return 1;
+			}
+		}
+
+		Serial.mute(true);
+		const int result = capture(frames, out);
+		if (out != stdout) fclose(out);
+		return result;
+	}
+	else if (argc >= 2 && strcmp(argv[1], "decode") == 0 && argc <= 3) {
+		FILE * in = argc == 3 ? fopen(argv[2], "rb") : stdin;
+		if (in == nullptr) {
+			fprintf(stderr, "Could not open '%s'\n", argv[2]);
+			return 1;
+		}
+		const int result = decode(in);
+		if (in != stdin) fclose(in);
+		return result;
+	}
+
+	fprintf(stderr, "Usage: %s capture [--frames n] [--out file]\n"
+	                "       %s decode [file]\n", argv[0], argv[0]);
+	return 1;
+}
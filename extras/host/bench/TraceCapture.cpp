@@ -0,0 +1,134 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Phase trace of several ports polled round-robin on the timed bus simulator,
+// written as Chrome trace JSON. Open the output in chrome://tracing or
+// ui.perfetto.dev. Usage: nxc_trace [--frames n] [--fault-every n] [--out file]
+//
+// Built with the library's NXC_ENABLE_TRACE option on. Port 0 is a Nunchuk at
+// 100 kHz, port 1 a Classic Controller at 400 kHz, and port 2 a knockoff NES
+// controller at 400 kHz with clock stretching. Port 1 drops bytes on a read
+// every '--fault-every' frames, to show what a spike looks like.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_SimController.h"
+#include "NXC_TimedBus.h"
+#include "NXC_TraceExport.h"
+
+#if !NXC_ENABLE_TRACE
+#error "nxc_trace needs the library built with NXC_ENABLE_TRACE"
+#endif
+
+using NXC_Host::SimulatedBus;
+using NXC_Host::SimulatedController;
+using NXC_Host::TimedBus;
+
+struct SimPort {
+	SimulatedBus bus;
+	SimulatedController sim;
+	TimedBus timed;
+	TwoWire wire;
+
+	SimPort(ExtensionType type, uint32_t clock) : sim(type), timed(bus, clock), wire(timed) {
+		bus.attach(SimulatedController::Address, sim);
+	}
+};
+
+int main(int argc, char * argv[]) {
+	uint32_t frames = 50;
+	uint32_t faultEvery = 20;
+	const char * outPath = nullptr;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--fault-every") == 0 && i + 1 < argc) {
+			faultEvery = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+			outPath = argv[++i];
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--frames n] [--fault-every n] [--out file]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	FILE * out = stdout;
+	if (outPath != nullptr && (out = fopen(outPath, "w")) == nullptr) {
+		fprintf(stderr, "Could not open '%s'\n", outPath);
+		return 1;
+	}
+
+	Serial.mute(true);
+
+	SimPort port0(ExtensionType::Nunchuk, 100000);
+	SimPort port1(ExtensionType::ClassicController, 400000);
+	SimPort port2(ExtensionType::ClassicController, 400000);
+
+	const uint8_t knockoffData[6] = { 0x81, 0x81, 0x81, 0x81, 0x00, 0x00 };
+	port2.sim.setControlData(knockoffData, sizeof(knockoffData));
+	port2.timed.setStretch(2.0);
+
+	Nunchuk nchuk(port0.wire);
+	ClassicController classic(port1.wire);
+	NESMiniController nes(port2.wire);
+
+	nchuk.begin();
+	classic.begin();
+	nes.begin();
+
+	if (!nchuk.connect() || !classic.connect() || !nes.connect()) {
+		fprintf(stderr, "Could not connect to the simulated controllers\n");
+		return 1;
+	}
+
+	NintendoExtensionCtrl::Trace::clear();  // Only trace the polling loop
+
+	for (uint32_t i = 0; i < frames; i++) {
+		if (faultEvery != 0 && i % faultEvery == faultEvery - 1) {
+			port1.timed.injectFault(TimedBus::FaultType::DropBytes, 2);
+		}
+
+		nchuk.update();
+		classic.update();
+		if (nes.update()) {
+			nes.fixKnockoffData();
+		}
+	}
+
+	NXC_Bench::ChromeTraceWriter writer(out);
+	writer.namePort(&nchuk.getExtensionData(), "port 0 (Nunchuk, 100 kHz)");
+	writer.namePort(&classic.getExtensionData(), "port 1 (Classic, 400 kHz)");
+	writer.namePort(&nes.getExtensionData(), "port 2 (NES knockoff, 400 kHz)");
+	writer.writeBuffer();
+
+	fprintf(stderr, "%u records traced, %u kept, %u events written\n",
+		NintendoExtensionCtrl::Trace::total(), NintendoExtensionCtrl::Trace::available(), writer.eventCount());
+
+	if (out != stdout) {
+		fclose(out);
+	}
+	return 0;
+}
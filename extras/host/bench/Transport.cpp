@@ -0,0 +1,139 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Transport comparison: ports on the 'Wire' stand-in and on a mock bus with
+// no virtual calls, in one program. Usage: nxc_transport [--csv] [--min-time ms]
+//
+// First checks that both ports read the same frames from their simulated
+// controllers, writing one JSON line. Then times update() and the raw
+// control data transaction on each bus, per request size. The simulated bus
+// time is the same for both, so the difference is the per-transaction cost
+// of the bus code.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_Bench.h"
+#include "NXC_DirectBus.h"
+#include "NXC_SimController.h"
+
+#include <string.h>
+
+using namespace NXC_Bench;
+using NXC_Host::DirectBus;
+using NXC_Host::SimulatedController;
+
+typedef NintendoExtensionCtrl::BuildControllerClass<ExtensionController, DirectBus> DirectPort;
+
+static SimulatedController wireSim;
+static SimulatedController directSim;
+
+static uint32_t checkFrames(ExtensionPort & wirePort, DirectPort & directPort, uint32_t frames) {
+	uint32_t state = 1;
+	uint32_t mismatches = 0;
+	uint8_t data[ExtensionController::MaxRequestSize];
+
+	for (uint32_t f = 0; f < frames; f++) {
+		for (uint8_t i = 0; i < sizeof(data); i++) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			data[i] = (uint8_t) state;
+		}
+		wireSim.setControlData(data, sizeof(data));
+		directSim.setControlData(data, sizeof(data));
+
+		const boolean a = wirePort.update();
+		const boolean b = directPort.update();
+		if (a != b) {
+			mismatches++;
+			continue;
+		}
+		for (uint8_t i = 0; i < wirePort.getRequestSize(); i++) {
+			if (wirePort.getControlData(i) != directPort.getControlData(i)) {
+				mismatches++;
+				break;
+			}
+		}
+	}
+	return mismatches;
+}
+
+int main(int argc, char * argv[]) {
+	Runner runner;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--csv") == 0) {
+			runner.setFormat(Runner::Format::CSV);
+		}
+		else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+			runner.setMinTime((uint32_t) atoi(argv[++i]));
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--csv] [--min-time ms]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);
+
+	NXC_Host::defaultBus().attach(SimulatedController::Address, wireSim);
+	DirectBus direct(directSim);
+
+	ExtensionPort wirePort;
+	DirectPort directPort(direct);
+
+	wirePort.begin();
+	directPort.begin();
+	if (!wirePort.connect() || !directPort.connect()) {
+		fprintf(stderr, "Could not connect to the simulated controllers\n");
+		return 1;
+	}
+
+	wirePort.setRequestSize(ExtensionController::MaxRequestSize);
+	directPort.setRequestSize(ExtensionController::MaxRequestSize);
+	const uint32_t frames = 10000;
+	const uint32_t mismatches = checkFrames(wirePort, directPort, frames);
+	printf("{\"check\":\"same_frames\",\"frames\":%u,\"mismatches\":%u}\n", frames, mismatches);
+
+	runner.header();
+
+	uint8_t buffer[ExtensionController::MaxRequestSize];
+	const uint8_t requestSizes[] = { 6, 8, 21 };
+	for (uint8_t size : requestSizes) {
+		char name[32];
+		wirePort.setRequestSize(size);
+		directPort.setRequestSize(size);
+
+		snprintf(name, sizeof(name), "update[%u]", size);
+		runner.run("wire", name, [&]() { sink += wirePort.update(); });
+		runner.run("direct", name, [&]() { sink += directPort.update(); });
+
+		snprintf(name, sizeof(name), "requestControlData[%u]", size);
+		runner.run("wire", name, [&]() { sink += NintendoExtensionCtrl::requestControlData(Wire, size, buffer); });
+		runner.run("direct", name, [&]() { sink += NintendoExtensionCtrl::requestControlData(direct, size, buffer); });
+	}
+
+	runner.run("wire", "readIdentity", [&]() { sink += wirePort.readIdentity(buffer); });
+	runner.run("direct", "readIdentity", [&]() { sink += directPort.readIdentity(buffer); });
+
+	return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// uinput bridge session, on a fake uinput sink by default.
+// Usage: nxc_uinput [--frames n] [--device /dev/uinput]
+//
+// Plugs each supported controller type into a simulated port in turn, with
+// its inputs following a random walk, and unplugs it again. A NES knockoff
+// runs as its own round. The bridge follows along through connect() and the
+// failed updates, creating and removing the device. After every poll the
+// fake sink's key and axis state is checked against the controller's
+// accessors. Writes one JSON line per round and one summary line.
+//
+// With '--device' the session drives a real uinput device instead (this
+// needs write access to /dev/uinput), and the state checks are skipped.
+
+#include <NintendoExtensionCtrl.h>
+
+#include "NXC_FakeUinput.h"
+#include "NXC_SimController.h"
+#include "NXC_Uinput.h"
+
+#include <string.h>
+
+using NXC_Host::FakeUinputSink;
+using NXC_Host::SimulatedController;
+using NXC_Host::UinputBridge;
+using NXC_Host::UinputDevice;
+using NXC_Host::UinputLayout;
+
+struct Round {
+	const char * name;
+	ExtensionType type;
+	bool knockoff;
+};
+
+static const Round Rounds[] = {
+	{ "nunchuk", ExtensionType::Nunchuk, false },
+	{ "classic", ExtensionType::ClassicController, false },
+	{ "nes_knockoff", ExtensionType::ClassicController, true },
+	{ "guitar", ExtensionType::GuitarController, false },
+	{ "drums", ExtensionType::DrumController, false },
+	{ "dj", ExtensionType::DJTurntableController, false },
+};
+
+// Compares the sink's state to what the accessors say
+static uint32_t checkState(const FakeUinputSink & sink, const UinputBridge & bridge, ExtensionPort & port) {
+	const UinputLayout * layout = bridge.getLayout();
+	if (layout == nullptr) return 1;
+
+	uint32_t mismatches = 0;
+
+	NintendoExtensionCtrl::ButtonRemap remap;
+	remap.compile(bridge.getType());
+	const uint16_t buttons = remap.map(port.getControlData(4), port.getControlData(5));
+	for (uint8_t b = 0; b < 16; b++) {
+		const int32_t k = sink.key(UinputBridge::keyCode(b));
+		if (k >= 0 && k != ((buttons >> b) & 1)) mismatches++;
+	}
+
+	int32_t axes[UinputLayout::MaxAxes];
+	const uint8_t n = UinputBridge::readAxes(bridge.getType(), port.getExtensionData(), axes);
+	for (uint8_t i = 0; i < n; i++) {
+		if (sink.axis(layout->axes[i].code) != axes[i]) mismatches++;
+	}
+	return mismatches;
+}
+
+int main(int argc, char * argv[]) {
+	uint32_t frames = 5000;
+	const char * device = nullptr;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = (uint32_t) atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--device") == 0 && i + 1 < argc) {
+			device = argv[++i];
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--frames n] [--device /dev/uinput]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Serial.mute(true);
+
+	NXC_Host::SimulatedBus bus;
+	SimulatedController sim;
+	TwoWire wire(bus);
+	ExtensionPort port(wire);
+	port.begin();
+	port.setRequestSize(8);  // Knockoffs put their buttons in bytes 6 and 7
+
+	FakeUinputSink fake;
+	UinputDevice real(device != nullptr ? device : "/dev/uinput");
+	NXC_Host::UinputSink & sink = device != nullptr ? (NXC_Host::UinputSink &) real : fake;
+
+	UinputBridge bridge(port, sink);
+	bridge.setReconnectInterval(5);
+
+	uint32_t state = 1;
+	uint32_t totalMismatches = 0;
+
+	for (const Round & r : Rounds) {
+		sim.setType(r.type);
+		sim.reset();
+		bus.attach(SimulatedController::Address, sim);
+
+		uint8_t data[8];
+		memcpy(data, sim.registerData(), sizeof(data));
+		if (r.knockoff) {
+			const uint8_t knockoff[8] = { 0x81, 0x81, 0x81, 0x81, 0x00, 0x00, 0xFF, 0xFF };
+			memcpy(data, knockoff, sizeof(data));
+		}
+
+		const NXC_Host::UinputBridge::Stats before = bridge.stats();
+		uint32_t mismatches = 0;
+		uint32_t polls = 0;
+
+		for (uint32_t f = 0; f < frames; f++) {
+			// xorshift32 random walk: nudge an axis byte, or flip a button bit
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+
+			if (r.knockoff) {
+				if ((state >> 8) % 16 == 0) data[6 + (state & 1)] ^= 1 << ((state >> 11) % 8);
+			}
+			else {
+				const uint8_t index = state % 6;
+				if (index < 4) {
+					data[index] += (uint8_t) ((state >> 8) % 5) - 2;
+				}
+				else if ((state >> 8) % 8 == 0) {
+					data[index] ^= 1 << ((state >> 11) % 8);
+				}
+				if (!NintendoExtensionCtrl::verifyData(data, 6)) {
+					data[0] ^= 0x01;  // Keep the frame valid
+				}
+			}
+			sim.setControlData(data, sizeof(data));
+
+			polls++;
+			if (bridge.poll() && device == nullptr) {
+				mismatches += checkState(fake, bridge, port);
+			}
+		}
+
+		// Unplug, and wait for the bridge to notice
+		bus.detach(SimulatedController::Address);
+		while (sink.isCreated() && polls < frames + 100) {
+			bridge.poll();
+			polls++;
+		}
+
+		const NXC_Host::UinputBridge::Stats & s = bridge.stats();
+		const uint32_t writes = s.writes - before.writes;
+		printf("{\"round\":\"%s\",\"polls\":%u,\"frames\":%u,\"writes\":%u,\"events_per_write\":%.2f,"
+			"\"plugs\":%u,\"unplugs\":%u,\"removed\":%s,\"mismatches\":%u}\n",
+			r.name, polls, s.frames - before.frames, writes,
+			writes ? (double) (s.events - before.events) / writes : 0.0,
+			s.plugs - before.plugs, s.unplugs - before.unplugs, sink.isCreated() ? "false" : "true", mismatches);
+		totalMismatches += mismatches;
+	}
+
+	const NXC_Host::UinputBridge::Stats & s = bridge.stats();
+	printf("{\"summary\":true,\"sink\":\"%s\",\"frames\":%u,\"writes\":%u,\"writes_per_frame\":%.3f,"
+		"\"latency_mean_ns\":%.1f,\"latency_max_ns\":%llu,\"sink_errors\":%u,\"mismatches\":%u}\n",
+		device != nullptr ? device : "fake", s.frames, s.writes, s.frames ? (double) s.writes / s.frames : 0.0,
+		s.writes ? (double) s.latencySumNs / s.writes : 0.0, (unsigned long long) s.latencyMaxNs,
+		device != nullptr ? 0 : fake.errors(), totalMismatches);
+
+	if (device != nullptr && s.plugs == 0) {
+		fprintf(stderr, "Could not create a uinput device on '%s': %s\n", device, strerror(real.lastError()));
+		return 1;
+	}
+	return (totalMismatches == 0 && (device != nullptr || fake.errors() == 0)) ? 0 : 1;
+}
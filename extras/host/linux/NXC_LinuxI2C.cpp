@@ -0,0 +1,258 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_LinuxI2C.h"
+#include "internal/NXC_Comms.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+namespace NXC_Host {
+	int I2CDevSyscalls::open(const char * path, int flags) { return ::open(path, flags); }
+	int I2CDevSyscalls::close(int fd) { return ::close(fd); }
+	int I2CDevSyscalls::ioctl(int fd, unsigned long request, void * arg) { return ::ioctl(fd, request, arg); }
+	ssize_t I2CDevSyscalls::read(int fd, void * buf, size_t count) { return ::read(fd, buf, count); }
+	ssize_t I2CDevSyscalls::write(int fd, const void * buf, size_t count) { return ::write(fd, buf, count); }
+
+	uint64_t I2CDevSyscalls::now() {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	}
+
+	int I2CDevSyscalls::sleepUntil(uint64_t deadline) {
+		struct timespec ts;
+		ts.tv_sec = deadline / 1000000000ULL;
+		ts.tv_nsec = deadline % 1000000000ULL;
+
+		int err;
+		do {
+			err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+		} while (err == EINTR);  // Absolute, so restarting doesn't stretch the wait
+		return err;
+	}
+
+	I2CDevSyscalls & I2CDevSyscalls::system() {
+		static I2CDevSyscalls sys;
+		return sys;
+	}
+
+	LinuxI2CBus::LinuxI2CBus(const char * device, Mode m, I2CDevSyscalls & syscalls) :
+		sys(syscalls), path(device), mode(m),
+		conversionNs((uint64_t) NintendoExtensionCtrl::I2C_ConversionDelay * 1000),
+		settleNs(20000000) {}
+
+	LinuxI2CBus::~LinuxI2CBus() {
+		close();
+	}
+
+	bool LinuxI2CBus::open() {
+		close();
+		fd = sys.open(path, O_RDWR | O_CLOEXEC);
+		if (fd < 0) {
+			error = errno;
+			return false;
+		}
+		return true;
+	}
+
+	void LinuxI2CBus::close() {
+		if (fd >= 0) {
+			sys.close(fd);
+			fd = -1;
+		}
+		slaveAddr = -1;
+		pointerAddr = -1;
+		armed = false;
+		readyAt = idleAt = 0;
+	}
+
+	void LinuxI2CBus::setMode(Mode m) {
+		mode = m;
+		armed = false;
+		slaveAddr = -1;
+	}
+
+	void LinuxI2CBus::begin() {
+		if (!isOpen()) {
+			open();
+		}
+	}
+
+	bool LinuxI2CBus::fail() {
+		error = errno;
+		stats.errors++;
+		pointerAddr = -1;  // Pointer state on the device is unknown
+		armed = false;
+		return false;
+	}
+
+	void LinuxI2CBus::waitUntil(uint64_t deadline) {
+		if (deadline == 0) return;
+
+		const uint64_t t = sys.now();
+		if (t >= deadline) return;
+
+		stats.sleeps++;
+		stats.sleepNs += deadline - t;
+		sys.sleepUntil(deadline);
+	}
+
+	bool LinuxI2CBus::transfer(i2c_msg * msgs, uint32_t count) {
+		struct i2c_rdwr_ioctl_data rdwr;
+		rdwr.msgs = msgs;
+		rdwr.nmsgs = count;
+
+		stats.syscalls++;
+		stats.messages += count;
+		if (sys.ioctl(fd, I2C_RDWR, &rdwr) < 0) {
+			return fail();
+		}
+		return true;
+	}
+
+	bool LinuxI2CBus::selectAddress(uint8_t addr) {
+		if (slaveAddr == addr) return true;
+
+		stats.syscalls++;
+		if (sys.ioctl(fd, I2C_SLAVE, (void *) (uintptr_t) addr) < 0) {
+			slaveAddr = -1;
+			return fail();
+		}
+		slaveAddr = addr;
+		return true;
+	}
+
+	uint8_t LinuxI2CBus::write(uint8_t addr, const uint8_t * data, size_t length) {
+		if (!isOpen()) return I2C_Error;
+
+		const bool pointerWrite = (length == 1);
+
+		// Already done along with the last read
+		if (armed && pointerWrite && pointerAddr == addr && data[0] == ControlPointer) {
+			armed = false;
+			stats.skippedWrites++;
+			return I2C_OK;
+		}
+		armed = false;
+
+		waitUntil(idleAt);
+
+		bool ok;
+		if (mode == Mode::ReadWrite) {
+			ok = selectAddress(addr);
+			if (ok) {
+				stats.syscalls++;
+				stats.messages++;
+				ok = sys.write(fd, data, length) == (ssize_t) length || fail();
+			}
+		}
+		else {
+			struct i2c_msg msg;
+			msg.addr = addr;
+			msg.flags = 0;
+			msg.len = (uint16_t) length;
+			msg.buf = (uint8_t *) data;
+			ok = transfer(&msg, 1);
+		}
+
+		if (!ok) {
+			// Most adapters report a missing ACK as ENXIO or EREMOTEIO
+			return (error == ENXIO || error == EREMOTEIO) ? I2C_AddrNACK : I2C_Error;
+		}
+
+		const uint64_t t = sys.now();
+		if (pointerWrite) {
+			pointerAddr = addr;
+			pointer = data[0];
+			readyAt = t + conversionNs;
+		}
+		else {
+			pointerAddr = -1;
+			idleAt = t + settleNs;
+			readyAt = 0;
+		}
+		return I2C_OK;
+	}
+
+	size_t LinuxI2CBus::read(uint8_t addr, uint8_t * data, size_t length) {
+		if (!isOpen()) return 0;
+
+		armed = false;
+		waitUntil(readyAt > idleAt ? readyAt : idleAt);
+		readyAt = 0;
+
+		if (mode == Mode::ReadWrite) {
+			if (!selectAddress(addr)) return 0;
+
+			stats.syscalls++;
+			stats.messages++;
+			const ssize_t n = sys.read(fd, data, length);
+			pointerAddr = -1;  // Auto-incremented by the read
+			if (n < 0) {
+				fail();
+				return 0;
+			}
+			return (size_t) n;
+		}
+
+		const bool rearm = mode == Mode::Pipelined && pointerAddr == addr && pointer == ControlPointer;
+		uint8_t ptr = ControlPointer;
+
+		struct i2c_msg msgs[2];
+		msgs[0].addr = addr;
+		msgs[0].flags = I2C_M_RD;
+		msgs[0].len = (uint16_t) length;
+		msgs[0].buf = data;
+
+		msgs[1].addr = addr;
+		msgs[1].flags = 0;
+		msgs[1].len = 1;
+		msgs[1].buf = &ptr;
+
+		pointerAddr = -1;
+		if (!transfer(msgs, rearm ? 2 : 1)) return 0;
+
+		if (rearm) {
+			pointerAddr = addr;
+			pointer = ControlPointer;
+			readyAt = sys.now() + conversionNs;
+			armed = true;
+		}
+		return length;  // The master clocks out every byte, there's no short read
+	}
+
+	const char * LinuxI2CBus::modeName(Mode m) {
+		switch (m) {
+			case(Mode::ReadWrite): return "readwrite";
+			case(Mode::Combined): return "combined";
+			case(Mode::Pipelined): return "pipelined";
+		}
+		return "unknown";
+	}
+}
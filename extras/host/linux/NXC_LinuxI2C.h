@@ -0,0 +1,137 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Linux i2c-dev backend for the host 'Wire' stand-in, for boards that talk to
+// controllers through /dev/i2c-N. Each Wire transaction becomes one I2C_RDWR
+// ioctl, instead of an I2C_SLAVE ioctl plus write() and read().
+//
+// The backend does its own bus waits: a read is held until the conversion
+// time after the last pointer write, and any transaction after a register
+// write is held for the settle time. It sleeps with clock_nanosleep() to an
+// absolute deadline on CLOCK_MONOTONIC, so time spent elsewhere since the
+// write counts towards the wait. Use it with the shim's simulated delays
+// (the default), otherwise the library waits as well.
+//
+// The system calls go through 'I2CDevSyscalls', so tests can swap in a fake
+// device layer (see sim/NXC_FakeI2CDev.h).
+
+#ifndef NXC_LinuxI2C_h
+#define NXC_LinuxI2C_h
+
+#include <Wire.h>
+
+#include <sys/types.h>
+
+struct i2c_msg;
+
+namespace NXC_Host {
+	class I2CDevSyscalls {
+	public:
+		virtual ~I2CDevSyscalls() {}
+
+		virtual int open(const char * path, int flags);
+		virtual int close(int fd);
+		virtual int ioctl(int fd, unsigned long request, void * arg);
+		virtual ssize_t read(int fd, void * buf, size_t count);
+		virtual ssize_t write(int fd, const void * buf, size_t count);
+
+		virtual uint64_t now();  // CLOCK_MONOTONIC, in nanoseconds
+		virtual int sleepUntil(uint64_t deadline);  // Absolute, in nanoseconds. 0 or an errno value
+
+		static I2CDevSyscalls & system();  // Straight through to the kernel
+	};
+
+	class LinuxI2CBus : public I2CBus {
+	public:
+		enum class Mode : uint8_t {
+			ReadWrite,  // I2C_SLAVE on address changes, then write() and read(), for comparison
+			Combined,   // One I2C_RDWR per transaction
+			Pipelined,  // Control data reads also re-arm the pointer, and the next pointer write is skipped
+		};
+
+		// In pipelined mode the read and the pointer write for the next frame
+		// share one I2C_RDWR, so polling takes one syscall per frame. The
+		// controller converts right after the read, which means each frame's
+		// data is as old as the time since the last poll.
+
+		struct Counters {
+			uint32_t syscalls;       // ioctl(), read() and write() calls
+			uint32_t messages;       // I2C messages sent to the kernel
+			uint32_t sleeps;         // Bus waits that had to sleep
+			uint64_t sleepNs;        // Total time asked for by those sleeps
+			uint32_t skippedWrites;  // Pointer writes already done by a pipelined read
+			uint32_t errors;
+		};
+
+		static const uint8_t ControlPointer = 0x00;
+
+		LinuxI2CBus(const char * device, Mode mode = Mode::Combined, I2CDevSyscalls & sys = I2CDevSyscalls::system());
+		~LinuxI2CBus();
+
+		bool open();  // 'false' on failure, see lastError()
+		void close();
+		bool isOpen() const { return fd >= 0; }
+
+		void setMode(Mode m);
+		Mode getMode() const { return mode; }
+
+		void setConversionTime(uint32_t us) { conversionNs = (uint64_t) us * 1000; }  // Pointer write to read
+		void setSettleTime(uint32_t us) { settleNs = (uint64_t) us * 1000; }          // After register writes
+
+		void begin() override;
+		uint8_t write(uint8_t addr, const uint8_t * data, size_t length) override;
+		size_t read(uint8_t addr, uint8_t * data, size_t length) override;
+
+		const Counters & counters() const { return stats; }
+		void resetCounters() { stats = {}; }
+		int lastError() const { return error; }  // errno of the last failed call
+
+		static const char * modeName(Mode m);
+
+	private:
+		bool transfer(i2c_msg * msgs, uint32_t count);
+		bool selectAddress(uint8_t addr);  // ReadWrite mode only
+		void waitUntil(uint64_t deadline);
+		bool fail();
+
+		I2CDevSyscalls & sys;
+		const char * path;
+		Mode mode;
+		int fd = -1;
+		int error = 0;
+
+		uint64_t conversionNs;
+		uint64_t settleNs;
+
+		uint64_t readyAt = 0;  // Earliest time for the next read
+		uint64_t idleAt = 0;   // Earliest time for the next transaction
+
+		int16_t pointerAddr = -1;  // Device whose pointer was last written, or -1
+		uint8_t pointer = 0;
+		bool armed = false;        // Pointer write for 'pointerAddr' already done by a pipelined read
+		int16_t slaveAddr = -1;    // Address set with I2C_SLAVE
+
+		Counters stats = {};
+	};
+}
+
+#endif
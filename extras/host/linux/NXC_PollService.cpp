@@ -0,0 +1,268 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_PollService.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace NXC_Host {
+	static uint64_t monotonicNs() {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	}
+
+	PollThread::PollThread(uint8_t threadID, uint32_t rateHz) :
+		id(threadID), rate(rateHz > 0 ? rateHz : 1)
+	{
+		for (std::atomic<uint64_t> & b : counters.late) {
+			b.store(0);
+		}
+	}
+
+	PollThread::~PollThread() {
+		stop();
+	}
+
+	bool PollThread::addPort(ExtensionController & controller, SelectFn select, void * context) {
+		if (isRunning() || numPorts >= MaxPorts) return false;
+		ports[numPorts++] = { &controller, select, context, false, 0, 0 };
+		return true;
+	}
+
+	bool PollThread::addConsumer(FrameQueue & queue) {
+		if (isRunning() || numConsumers >= MaxConsumers) return false;
+		consumers[numConsumers++] = &queue;
+		return true;
+	}
+
+	bool PollThread::start() {
+		if (isRunning()) return false;
+		stop();  // Reap a thread that ended on its own
+
+		timer = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+		if (timer < 0) return false;
+
+		running.store(true);
+		if (pthread_create(&thread, nullptr, &PollThread::entry, this) != 0) {
+			running.store(false);
+			close(timer);
+			timer = -1;
+			return false;
+		}
+		started = true;
+		return true;
+	}
+
+	void PollThread::stop() {
+		if (!started) return;  // Joined and closed whether or not it's still running
+
+		running.store(false);  // Seen on the next tick
+		pthread_join(thread, nullptr);
+		close(timer);
+		timer = -1;
+		started = false;
+	}
+
+	void * PollThread::entry(void * self) {
+		static_cast<PollThread *>(self)->run();
+		return nullptr;
+	}
+
+	void PollThread::applyScheduling() {
+		if (cpuAffinity >= 0) {
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpuAffinity, &set);
+			const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+			if (err != 0) schedError.store(err);
+		}
+
+		if (fifoPriority > 0) {
+			struct sched_param param = {};
+			param.sched_priority = fifoPriority;
+			const int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+			if (err != 0) schedError.store(err);  // Usually EPERM, needs CAP_SYS_NICE
+		}
+	}
+
+	void PollThread::run() {
+		applyScheduling();
+
+		const uint64_t period = 1000000000ULL / rate;
+		uint64_t next = monotonicNs() + period;
+
+		// Absolute start, so the schedule doesn't drift with the setup time
+		struct itimerspec spec = {};
+		spec.it_interval.tv_sec = period / 1000000000ULL;
+		spec.it_interval.tv_nsec = period % 1000000000ULL;
+		spec.it_value.tv_sec = next / 1000000000ULL;
+		spec.it_value.tv_nsec = next % 1000000000ULL;
+		if (timerfd_settime(timer, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+			running.store(false);
+			return;
+		}
+
+		uint32_t tick = 0;
+		while (running.load(std::memory_order_relaxed)) {
+			uint64_t expirations = 0;
+			if (::read(timer, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+				if (errno == EINTR) continue;
+				running.store(false);  // Timer gone, stop() still joins
+				break;
+			}
+
+			const uint64_t woke = monotonicNs();
+
+			// Serve only the latest tick, and count the ones that were missed
+			next += period * (expirations - 1);
+			tick += (uint32_t) expirations;
+			if (expirations > 1) {
+				bump(counters.missedTicks, expirations - 1);
+			}
+			recordLateness(woke > next ? woke - next : 0);
+			next += period;
+
+			poll(tick);
+
+			bump(counters.ticks);
+			raise(counters.workMaxNs, monotonicNs() - woke);
+		}
+	}
+
+	void PollThread::poll(uint32_t tick) {
+		for (uint8_t i = 0; i < numPorts; i++) {
+			Port & p = ports[i];
+			ExtensionController & c = *p.controller;
+
+			if (!p.connected && (int32_t) (tick - p.retryTick) < 0) continue;  // Wait to retry
+
+			if (p.select != nullptr) {
+				p.select(p.context);
+			}
+
+			bool ok;
+			if (p.connected) {
+				ok = c.update();
+				if (ok) {
+					p.failures = 0;
+				}
+				else {
+					bump(counters.updateFailures);
+					if (++p.failures >= FailureLimit) {
+						p.connected = false;  // Published as failed below, then retried
+						p.retryTick = tick + reconnectTicks;
+					}
+				}
+			}
+			else {
+				ok = c.connect();
+				if (!ok) {
+					p.retryTick = tick + reconnectTicks;
+					continue;
+				}
+				bump(counters.reconnects);
+				p.connected = true;
+				p.failures = 0;
+			}
+
+			PolledFrame frame;
+			frame.time = monotonicNs();
+			frame.tick = tick;
+			frame.bus = id;
+			frame.port = i;
+			frame.ok = ok;
+			frame.type = p.connected ? c.getControllerType() : ExtensionType::NoController;
+			frame.size = c.getRequestSize();
+			for (uint8_t b = 0; b < frame.size; b++) {
+				frame.data[b] = c.getControlData(b);  // Last good frame, if this one failed
+			}
+			publish(frame);
+		}
+	}
+
+	void PollThread::publish(const PolledFrame & frame) {
+		for (uint8_t i = 0; i < numConsumers; i++) {
+			if (!consumers[i]->push(frame)) {
+				bump(counters.framesDropped);
+			}
+		}
+	}
+
+	void PollThread::recordLateness(uint64_t ns) {
+		bump(counters.lateSumNs, ns);
+		raise(counters.lateMaxNs, ns);
+
+		uint8_t bucket = 0;
+		for (uint64_t us = ns / 1000; us > 0 && bucket < LateBuckets - 1; us >>= 1) {
+			bucket++;
+		}
+		bump(counters.late[bucket]);
+	}
+
+	// Only the poll thread writes the counters, so a plain load and store is
+	// enough, and readers never see a torn value
+	void PollThread::bump(std::atomic<uint64_t> & c, uint64_t n) {
+		c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	void PollThread::raise(std::atomic<uint64_t> & c, uint64_t v) {
+		if (v > c.load(std::memory_order_relaxed)) {
+			c.store(v, std::memory_order_relaxed);
+		}
+	}
+
+	PollThread::Stats PollThread::stats() const {
+		Stats s;
+		s.ticks = counters.ticks.load(std::memory_order_relaxed);
+		s.missedTicks = counters.missedTicks.load(std::memory_order_relaxed);
+		s.lateSumNs = counters.lateSumNs.load(std::memory_order_relaxed);
+		s.lateMaxNs = counters.lateMaxNs.load(std::memory_order_relaxed);
+		s.workMaxNs = counters.workMaxNs.load(std::memory_order_relaxed);
+		s.updateFailures = counters.updateFailures.load(std::memory_order_relaxed);
+		s.reconnects = counters.reconnects.load(std::memory_order_relaxed);
+		s.framesDropped = counters.framesDropped.load(std::memory_order_relaxed);
+		for (uint8_t i = 0; i < LateBuckets; i++) {
+			s.late[i] = counters.late[i].load(std::memory_order_relaxed);
+		}
+		return s;
+	}
+
+	uint64_t PollThread::latePercentileUs(const Stats & s, double fraction) {
+		uint64_t total = 0;
+		for (uint64_t n : s.late) total += n;
+		if (total == 0) return 0;
+
+		const uint64_t target = (uint64_t) (fraction * total + 0.5);
+		uint64_t seen = 0;
+		for (uint8_t i = 0; i < LateBuckets; i++) {
+			seen += s.late[i];
+			if (seen >= target) return 1ULL << i;
+		}
+		return 1ULL << (LateBuckets - 1);
+	}
+}
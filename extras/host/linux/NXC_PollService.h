@@ -0,0 +1,147 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_PollService_h
+#define NXC_PollService_h
+
+#include "internal/ExtensionController.h"
+#include "NXC_SpscQueue.h"
+
+#include <pthread.h>
+
+namespace NXC_Host {
+	// One polled frame: the raw control data and controller type for a port,
+	// which the consumer decodes with the controller's 'Shared' class.
+	struct PolledFrame {
+		uint64_t time;      // CLOCK_MONOTONIC at the end of the update, in ns
+		uint32_t tick;      // Poll tick of the thread that read it
+		uint8_t bus;        // Poll thread ID
+		uint8_t port;       // Port index on that thread
+		ExtensionType type; // NoController when the port isn't connected
+		uint8_t size;       // Request size, bytes of 'data' that are valid
+		bool ok;            // 'false' if the update failed
+		uint8_t data[ExtensionController::MaxRequestSize];
+	};
+
+	typedef SpscQueue<PolledFrame, 256> FrameQueue;
+
+	// Polls the ports on one bus from its own thread, at a fixed rate set by a
+	// timerfd. Each tick every port is updated in turn, and the frames are
+	// pushed to each consumer's queue. A bus that runs slow only delays its own
+	// thread. A port that fails several updates in a row is retried at the
+	// reconnect interval, so a missing controller doesn't spend the bus on
+	// every tick.
+	//
+	// Everything is set up before start(): the ports, consumers and scheduling
+	// are read by the thread without locks. Each queue must have one consumer
+	// thread, so a consumer that wants every bus takes one queue per thread.
+	class PollThread {
+	public:
+		typedef void (*SelectFn)(void * context);  // Called before a port is polled, e.g. to switch a mux
+
+		static const uint8_t MaxPorts = 8;
+		static const uint8_t MaxConsumers = 4;
+		static const uint8_t LateBuckets = 16;  // Powers of two, in microseconds
+		static const uint8_t FailureLimit = 8;  // Failed updates in a row before a port is disconnected
+
+		struct Stats {
+			uint64_t ticks;          // Ticks served
+			uint64_t missedTicks;    // Ticks that passed while the thread was still busy
+			uint64_t lateSumNs;      // Wakeup lateness against the tick schedule
+			uint64_t lateMaxNs;
+			uint64_t late[LateBuckets];  // Bucket n: lateness below 2^n us (the last is open-ended)
+			uint64_t workMaxNs;      // Longest time spent polling in one tick
+			uint64_t updateFailures;
+			uint64_t reconnects;     // Successful connects
+			uint64_t framesDropped;  // Frames not pushed because a queue was full
+		};
+
+		PollThread(uint8_t id, uint32_t rateHz = 1000);
+		~PollThread();
+
+		bool addPort(ExtensionController & controller, SelectFn select = nullptr, void * context = nullptr);
+		bool addConsumer(FrameQueue & queue);
+
+		void setAffinity(int cpu) { cpuAffinity = cpu; }  // -1 for none
+		void setFifoPriority(int priority) { fifoPriority = priority; }  // SCHED_FIFO, 0 for normal
+		void setReconnectInterval(uint32_t t) { reconnectTicks = t; }  // Ticks between connect attempts
+
+		bool start();  // 'false' if the thread or timer couldn't be created
+		void stop();
+		bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+		Stats stats() const;  // Safe to call while running
+		int schedulingError() const { return schedError.load(); }  // errno from pinning or SCHED_FIFO, 0 if fine
+
+		uint8_t getID() const { return id; }
+		uint32_t getRate() const { return rate; }
+
+		static uint64_t latePercentileUs(const Stats & s, double fraction);  // Bucket upper bound
+
+	private:
+		struct Port {
+			ExtensionController * controller;
+			SelectFn select;
+			void * context;
+			bool connected;
+			uint8_t failures;    // Failed updates in a row
+			uint32_t retryTick;  // Next connect attempt, while disconnected
+		};
+
+		struct Counters {
+			std::atomic<uint64_t> ticks{0}, missedTicks{0}, lateSumNs{0}, lateMaxNs{0}, workMaxNs{0};
+			std::atomic<uint64_t> updateFailures{0}, reconnects{0}, framesDropped{0};
+			std::atomic<uint64_t> late[LateBuckets];  // Zeroed by the constructor
+		};
+
+		static void * entry(void * self);
+		void run();
+		void applyScheduling();
+		void poll(uint32_t tick);
+		void publish(const PolledFrame & frame);
+		void recordLateness(uint64_t ns);
+		static void bump(std::atomic<uint64_t> & c, uint64_t n = 1);
+		static void raise(std::atomic<uint64_t> & c, uint64_t v);
+
+		const uint8_t id;
+		const uint32_t rate;
+
+		Port ports[MaxPorts];
+		uint8_t numPorts = 0;
+		FrameQueue * consumers[MaxConsumers];
+		uint8_t numConsumers = 0;
+
+		int cpuAffinity = -1;
+		int fifoPriority = 0;
+		uint32_t reconnectTicks = 100;
+		std::atomic<int> schedError{0};
+
+		int timer = -1;
+		pthread_t thread;
+		std::atomic<bool> running{false};  // Cleared by stop(), or by the thread if its timer fails
+		bool started = false;  // Thread created and not joined yet, even if it has stopped running
+
+		Counters counters;
+	};
+}
+
+#endif
@@ -0,0 +1,242 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_SharedState.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace NXC_Host {
+	static const char SharedMagic[4] = { 'N', 'X', 'C', 'S' };
+
+	static uint64_t monotonicNs() {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	}
+
+	static size_t regionSize(uint8_t slots) {
+		return sizeof(SharedHeader) + (size_t) slots * sizeof(SharedSlot);
+	}
+
+	// Publisher
+	// --------------------
+	SharedStatePublisher::~SharedStatePublisher() {
+		close();
+	}
+
+	bool SharedStatePublisher::fail() {
+		error = errno;
+		return false;
+	}
+
+	bool SharedStatePublisher::create(const char * name, uint8_t slots, mode_t mode) {
+		close();
+
+		if (slots == 0 || slots > MaxSlots || strlen(name) >= sizeof(path)) {
+			error = EINVAL;
+			return false;
+		}
+
+		const int fd = shm_open(name, O_CREAT | O_RDWR | O_CLOEXEC, mode);
+		if (fd < 0) return fail();
+
+		const size_t size = regionSize(slots);
+		if (ftruncate(fd, (off_t) size) != 0) {
+			fail();
+			::close(fd);
+			return false;
+		}
+
+		void * map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);  // The mapping keeps the object open
+		if (map == MAP_FAILED) return fail();
+
+		region = (uint8_t *) map;
+		length = size;
+		count = slots;
+		strcpy(path, name);
+
+		memset(region, 0, size);  // Readers see empty, even slots until the first publish
+
+		SharedHeader * header = (SharedHeader *) region;
+		header->version = Version;
+		header->slotSize = sizeof(SharedSlot);
+		header->slots = slots;
+		header->pid = (uint32_t) getpid();
+		std::atomic_thread_fence(std::memory_order_release);
+		memcpy(header->magic, SharedMagic, sizeof(SharedMagic));  // Last, marks the header complete
+
+		return true;
+	}
+
+	void SharedStatePublisher::close(bool unlink) {
+		if (region == nullptr) return;
+
+		munmap(region, length);
+		if (unlink) {
+			shm_unlink(path);  // Readers keep their mappings
+		}
+		region = nullptr;
+		length = 0;
+		count = 0;
+	}
+
+	bool SharedStatePublisher::publish(uint8_t n, ExtensionType type, const uint8_t * data, uint8_t size, uint64_t time) {
+		if (region == nullptr || n >= count) return false;
+		if (size > sizeof(SharedSlot::data)) size = sizeof(SharedSlot::data);
+
+		SharedSlot & s = ((SharedSlot *) (region + sizeof(SharedHeader)))[n];
+
+		const uint32_t seq = s.sequence.load(std::memory_order_relaxed);
+		s.sequence.store(seq + 1, std::memory_order_relaxed);  // Odd, writing
+		std::atomic_thread_fence(std::memory_order_release);
+
+		s.type = (uint8_t) type;
+		s.size = size;
+		s.time = time;
+		s.frames++;
+		memcpy(s.data, data, size);
+
+		s.sequence.store(seq + 2, std::memory_order_release);  // Even, done
+		return true;
+	}
+
+	bool SharedStatePublisher::publish(uint8_t slot, const ExtensionController & controller) {
+		uint8_t data[ExtensionController::MaxRequestSize];
+		const uint8_t size = controller.getRequestSize();
+		for (uint8_t i = 0; i < size; i++) {
+			data[i] = controller.getControlData(i);
+		}
+		return publish(slot, controller.getControllerType(), data, size, monotonicNs());
+	}
+
+	bool SharedStatePublisher::publish(uint8_t slot, const PolledFrame & frame) {
+		return publish(slot, frame.ok ? frame.type : ExtensionType::NoController, frame.data, frame.size, frame.time);
+	}
+
+	// Reader
+	// --------------------
+	SharedStateReader::~SharedStateReader() {
+		close();
+	}
+
+	bool SharedStateReader::open(const char * name) {
+		close();
+
+		const int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+		if (fd < 0) {
+			error = errno;
+			return false;
+		}
+
+		void * map = MAP_FAILED;
+		SharedHeader header;
+		const ssize_t n = pread(fd, &header, sizeof(header), 0);
+		if (n == (ssize_t) sizeof(header)) {
+			map = mmap(nullptr, regionSize(header.slots), PROT_READ, MAP_SHARED, fd, 0);
+		}
+		error = (n < 0 || map == MAP_FAILED) ? errno : 0;
+		::close(fd);
+
+		if (n != (ssize_t) sizeof(header) || memcmp(header.magic, SharedMagic, sizeof(SharedMagic)) != 0 ||
+			header.version != SharedStatePublisher::Version || header.slotSize != sizeof(SharedSlot) ||
+			header.slots == 0)
+		{
+			if (map != MAP_FAILED) munmap(map, regionSize(header.slots));
+			if (error == 0) error = EPROTO;  // Not ready yet, or a different version
+			return false;
+		}
+		if (map == MAP_FAILED) return false;
+
+		region = (const uint8_t *) map;
+		length = regionSize(header.slots);
+		count = header.slots;
+		return true;
+	}
+
+	void SharedStateReader::close() {
+		if (region == nullptr) return;
+
+		munmap((void *) region, length);
+		region = nullptr;
+		length = 0;
+		count = 0;
+	}
+
+	const SharedSlot * SharedStateReader::slot(uint8_t n) const {
+		if (region == nullptr || n >= count) return nullptr;
+		return &((const SharedSlot *) (region + sizeof(SharedHeader)))[n];
+	}
+
+	uint32_t SharedStateReader::sequence(uint8_t n) const {
+		const SharedSlot * s = slot(n);
+		return s != nullptr ? s->sequence.load(std::memory_order_acquire) : 0;
+	}
+
+	uint32_t SharedStateReader::publisherPID() const {
+		return region != nullptr ? ((const SharedHeader *) region)->pid : 0;
+	}
+
+	bool SharedStateReader::read(uint8_t n, SharedFrame & out) const {
+		const SharedSlot * s = slot(n);
+		if (s == nullptr) return false;
+
+		for (uint8_t tries = 0; tries < MaxRetries; tries++) {
+			const uint32_t before = s->sequence.load(std::memory_order_acquire);
+			if (before & 1) continue;  // Mid-write
+
+			out.type = (ExtensionType) s->type;
+			out.size = s->size;
+			out.time = s->time;
+			out.frames = s->frames;
+			memcpy(out.data, s->data, sizeof(out.data));
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (s->sequence.load(std::memory_order_relaxed) == before) {
+				if (out.size > sizeof(out.data)) out.size = sizeof(out.data);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Port view
+	// --------------------
+	bool SharedPort::refresh(const SharedStateReader & reader, uint8_t slot) {
+		SharedFrame f;
+		if (!reader.read(slot, f) || f.frames == frames) return false;
+
+		for (uint8_t i = 0; i < f.size; i++) {
+			setControlData(i, f.data[i]);
+		}
+		setRequestSize(f.size);
+		type = f.type;
+		time = f.time;
+		frames = f.frames;
+		return true;
+	}
+}
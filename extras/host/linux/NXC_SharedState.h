@@ -0,0 +1,154 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Publishes controller state to other processes through POSIX shared memory.
+// The region is a header followed by one slot per port, each on its own
+// cache line:
+//
+//   Header (64 bytes): magic "NXCS", version, slot size, slot count, publisher PID
+//   Slot   (64 bytes): sequence, type, request size, timestamp, frame count, control data
+//
+// Each slot is a seqlock with a single writer. The sequence is odd while the
+// slot is being written. Readers copy the slot and check that the sequence
+// was even and unchanged, so reading needs no syscall and no lock, and a
+// reader can never hold up the publisher. The timestamp is CLOCK_MONOTONIC,
+// which is the same for every process on the machine.
+
+#ifndef NXC_SharedState_h
+#define NXC_SharedState_h
+
+#include "internal/ExtensionController.h"
+#include "NXC_PollService.h"
+
+#include <atomic>
+#include <sys/types.h>
+
+namespace NXC_Host {
+	static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared memory sequences need lock-free atomics");
+
+	struct SharedHeader {
+		char magic[4];     // "NXCS"
+		uint16_t version;
+		uint16_t slotSize; // sizeof(SharedSlot), to catch mismatched builds
+		uint8_t slots;
+		uint8_t reserved[3];
+		uint32_t pid;      // Publisher process
+		uint8_t padding[48];
+	};
+
+	struct alignas(64) SharedSlot {
+		std::atomic<uint32_t> sequence;  // Odd while being written
+		uint8_t type;      // ExtensionType, NoController when the port is empty
+		uint8_t size;      // Bytes of 'data' that are valid
+		uint8_t reserved[2];
+		uint64_t time;     // CLOCK_MONOTONIC when published, in ns
+		uint32_t frames;   // Frames published to this slot
+		uint8_t data[ExtensionController::MaxRequestSize];
+	};
+
+	static_assert(sizeof(SharedHeader) == 64, "Shared header layout");
+	static_assert(sizeof(SharedSlot) == 64, "Shared slot layout");
+
+	// A consistent copy of one slot
+	struct SharedFrame {
+		ExtensionType type;
+		uint8_t size;
+		uint64_t time;
+		uint32_t frames;
+		uint8_t data[ExtensionController::MaxRequestSize];
+	};
+
+	class SharedStatePublisher {
+	public:
+		static const uint16_t Version = 1;
+		static const uint8_t MaxSlots = 64;
+
+		~SharedStatePublisher();
+
+		bool create(const char * name, uint8_t slots, mode_t mode = 0644);  // e.g. "/nxc"
+		void close(bool unlink = true);
+		bool isOpen() const { return region != nullptr; }
+
+		bool publish(uint8_t slot, ExtensionType type, const uint8_t * data, uint8_t size, uint64_t time);
+		bool publish(uint8_t slot, const ExtensionController & controller);
+		bool publish(uint8_t slot, const PolledFrame & frame);
+
+		uint8_t slots() const { return count; }
+		int lastError() const { return error; }
+
+	private:
+		bool fail();
+
+		char path[64] = {};
+		uint8_t * region = nullptr;
+		size_t length = 0;
+		uint8_t count = 0;
+		int error = 0;
+	};
+
+	class SharedStateReader {
+	public:
+		static const uint8_t MaxRetries = 64;  // Reads give up rather than wait on a writer
+
+		~SharedStateReader();
+
+		bool open(const char * name);
+		void close();
+		bool isOpen() const { return region != nullptr; }
+
+		bool read(uint8_t slot, SharedFrame & out) const;  // 'false' if out of range, or still busy after MaxRetries
+		uint32_t sequence(uint8_t slot) const;  // Cheap check for a new frame
+
+		uint8_t slots() const { return count; }
+		uint32_t publisherPID() const;
+		int lastError() const { return error; }
+
+	private:
+		const SharedSlot * slot(uint8_t n) const;
+
+		const uint8_t * region = nullptr;
+		size_t length = 0;
+		uint8_t count = 0;
+		int error = 0;
+	};
+
+	// Holds the latest frame from a slot in its own ExtensionData, so any
+	// controller's 'Shared' class can decode it:
+	//   SharedPort port;
+	//   ClassicController::Shared classic(port.getExtensionData());
+	//   if (port.refresh(reader, 0)) { classic.buttonA(); ... }
+	// The port never touches the bus. Its type comes from the slot, see getType().
+	class SharedPort : public ExtensionPort {
+	public:
+		bool refresh(const SharedStateReader & reader, uint8_t slot);  // 'true' if there's a new frame
+
+		ExtensionType getType() const { return type; }
+		uint64_t getTime() const { return time; }
+
+	private:
+		ExtensionType type = ExtensionType::NoController;
+		uint64_t time = 0;
+		uint32_t frames = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,80 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_SpscQueue_h
+#define NXC_SpscQueue_h
+
+#include <atomic>
+#include <stddef.h>
+
+namespace NXC_Host {
+	// Bounded lock-free queue for exactly one producer thread and one consumer
+	// thread. 'Size' must be a power of two, and one slot is always left empty.
+	// The indices sit on their own cache lines, and each side keeps a copy of
+	// the other's index so it only reads the shared one when the cached copy
+	// says the queue is full (or empty).
+	template<class T, size_t Size>
+	class SpscQueue {
+	public:
+		static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Queue size must be a power of two");
+
+		bool push(const T & item) {  // Producer only. 'false' if full
+			const size_t h = head.load(std::memory_order_relaxed);
+			const size_t next = (h + 1) & Mask;
+			if (next == tailCache) {
+				tailCache = tail.load(std::memory_order_acquire);
+				if (next == tailCache) return false;
+			}
+			slots[h] = item;
+			head.store(next, std::memory_order_release);
+			return true;
+		}
+
+		bool pop(T & item) {  // Consumer only. 'false' if empty
+			const size_t t = tail.load(std::memory_order_relaxed);
+			if (t == headCache) {
+				headCache = head.load(std::memory_order_acquire);
+				if (t == headCache) return false;
+			}
+			item = slots[t];
+			tail.store((t + 1) & Mask, std::memory_order_release);
+			return true;
+		}
+
+		size_t size() const {  // Approximate, from either side
+			return (head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire)) & Mask;
+		}
+
+		static constexpr size_t capacity() { return Size - 1; }
+
+	private:
+		static const size_t Mask = Size - 1;
+
+		alignas(64) std::atomic<size_t> head{0};  // Written by the producer
+		size_t tailCache = 0;
+		alignas(64) std::atomic<size_t> tail{0};  // Written by the consumer
+		size_t headCache = 0;
+		alignas(64) T slots[Size];
+	};
+}
+
+#endif
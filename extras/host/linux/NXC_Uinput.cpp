@@ -0,0 +1,340 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Uinput.h"
+
+#include "controllers/Nunchuk.h"
+#include "controllers/ClassicController.h"
+#include "controllers/GuitarController.h"
+#include "controllers/DrumController.h"
+#include "controllers/DJTurntable.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <linux/input.h>
+#include <linux/uinput.h>
+
+namespace NXC_Host {
+	using NintendoExtensionCtrl::DefaultRemapProfile;
+	using NintendoExtensionCtrl::DefaultRemapProfileSize;
+
+	static uint64_t monotonicNs() {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	}
+
+	// Device
+	// --------------------
+	UinputDevice::~UinputDevice() {
+		destroy();
+	}
+
+	bool UinputDevice::fail() {
+		error = errno;
+		if (fd >= 0) {
+			::close(fd);
+			fd = -1;
+		}
+		return false;
+	}
+
+	bool UinputDevice::create(const UinputLayout & layout) {
+		destroy();
+
+		fd = ::open(path, O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+		if (fd < 0) return fail();
+
+		if (ioctl(fd, UI_SET_EVBIT, EV_KEY) < 0) return fail();
+		for (uint8_t i = 0; i < layout.numKeys; i++) {
+			if (ioctl(fd, UI_SET_KEYBIT, layout.keys[i]) < 0) return fail();
+		}
+
+		if (layout.numAxes > 0 && ioctl(fd, UI_SET_EVBIT, EV_ABS) < 0) return fail();
+		for (uint8_t i = 0; i < layout.numAxes; i++) {
+			struct uinput_abs_setup abs = {};
+			abs.code = layout.axes[i].code;
+			abs.absinfo.minimum = layout.axes[i].min;
+			abs.absinfo.maximum = layout.axes[i].max;
+			if (ioctl(fd, UI_SET_ABSBIT, abs.code) < 0 || ioctl(fd, UI_ABS_SETUP, &abs) < 0) return fail();
+		}
+
+		struct uinput_setup setup = {};
+		setup.id.bustype = BUS_I2C;
+		setup.id.vendor = 0x057E;  // Nintendo
+		setup.id.product = layout.product;
+		strncpy(setup.name, layout.name, UINPUT_MAX_NAME_SIZE - 1);
+
+		if (ioctl(fd, UI_DEV_SETUP, &setup) < 0 || ioctl(fd, UI_DEV_CREATE) < 0) return fail();
+		return true;
+	}
+
+	bool UinputDevice::emit(const struct input_event * events, size_t count) {
+		if (fd < 0) return false;
+
+		const ssize_t size = (ssize_t) (count * sizeof(struct input_event));
+		if (::write(fd, events, size) != size) {
+			error = errno;
+			return false;
+		}
+		return true;
+	}
+
+	void UinputDevice::destroy() {
+		if (fd < 0) return;
+
+		ioctl(fd, UI_DEV_DESTROY);
+		::close(fd);
+		fd = -1;
+	}
+
+	// Layouts
+	// --------------------
+	struct TypeLayout {
+		ExtensionType type;
+		const char * name;
+		uint16_t product;
+		UinputAxis axes[UinputLayout::MaxAxes];
+		uint8_t numAxes;
+	};
+
+	// Y axes are flipped when read, evdev has up as the minimum
+	static const TypeLayout TypeLayouts[] = {
+		{ ExtensionType::Nunchuk, "Nintendo Wii Nunchuk", 0x0001,
+			{ { ABS_X, 0, 255 }, { ABS_Y, 0, 255 } }, 2 },
+		{ ExtensionType::ClassicController, "Nintendo Wii Classic Controller", 0x0002,  // NES and SNES Mini too
+			{ { ABS_X, 0, 63 }, { ABS_Y, 0, 63 }, { ABS_RX, 0, 31 }, { ABS_RY, 0, 31 }, { ABS_Z, 0, 31 }, { ABS_RZ, 0, 31 } }, 6 },
+		{ ExtensionType::GuitarController, "Nintendo Wii Guitar", 0x0003,
+			{ { ABS_X, 0, 63 }, { ABS_Y, 0, 63 }, { ABS_RX, 0, 31 }, { ABS_RY, 0, 31 } }, 4 },  // Whammy bar, touchbar
+		{ ExtensionType::DrumController, "Nintendo Wii Drums", 0x0004,
+			{ { ABS_X, 0, 63 }, { ABS_Y, 0, 63 } }, 2 },
+		{ ExtensionType::DJTurntableController, "Nintendo Wii DJ Turntable", 0x0005,
+			{ { ABS_X, 0, 63 }, { ABS_Y, 0, 63 }, { ABS_RX, -32, 31 }, { ABS_RY, -32, 31 }, { ABS_Z, -8, 7 }, { ABS_RZ, 0, 31 } }, 6 },  // Left and right tables, crossfader, effect dial
+	};
+
+	// Standard gamepad codes for each VirtualGamepad bit, A first. Nintendo's
+	// A is the right face button, and B the bottom one.
+	static const uint16_t KeyCodes[16] = {
+		BTN_EAST, BTN_SOUTH, BTN_NORTH, BTN_WEST,
+		BTN_TL, BTN_TR, BTN_TL2, BTN_TR2,
+		BTN_START, BTN_SELECT, BTN_MODE,
+		BTN_DPAD_UP, BTN_DPAD_DOWN, BTN_DPAD_LEFT, BTN_DPAD_RIGHT,
+		BTN_TRIGGER_HAPPY1,  // Extra
+	};
+
+	uint16_t UinputBridge::keyCode(uint8_t virtualButton) {
+		return virtualButton < 16 ? KeyCodes[virtualButton] : 0;
+	}
+
+	bool UinputBridge::buildLayout(ExtensionType type, UinputLayout & out) {
+		for (const TypeLayout & t : TypeLayouts) {
+			if (t.type != type) continue;
+
+			out.name = t.name;
+			out.product = t.product;
+			out.numAxes = t.numAxes;
+			memcpy(out.axes, t.axes, sizeof(out.axes));
+
+			uint16_t buttons = 0;
+			for (size_t i = 0; i < DefaultRemapProfileSize; i++) {
+				if (DefaultRemapProfile[i].type == type) {
+					buttons |= DefaultRemapProfile[i].output;
+				}
+			}
+
+			out.numKeys = 0;
+			for (uint8_t b = 0; b < 16; b++) {
+				if (buttons & (1 << b)) {
+					out.keys[out.numKeys++] = KeyCodes[b];
+				}
+			}
+			return true;
+		}
+		return false;
+	}
+
+	uint8_t UinputBridge::readAxes(ExtensionType type, ExtensionController::ExtensionData & data, int32_t * out) {
+		switch (type) {
+			case(ExtensionType::Nunchuk): {
+				Nunchuk::Shared c(data);
+				out[0] = c.joyX();
+				out[1] = 255 - c.joyY();
+				return 2;
+			}
+			case(ExtensionType::ClassicController): {
+				ClassicController::Shared c(data);
+				out[0] = c.leftJoyX();
+				out[1] = 63 - c.leftJoyY();
+				out[2] = c.rightJoyX();
+				out[3] = 31 - c.rightJoyY();
+				out[4] = c.triggerL();
+				out[5] = c.triggerR();
+				return 6;
+			}
+			case(ExtensionType::GuitarController): {
+				GuitarController::Shared c(data);
+				out[0] = c.joyX();
+				out[1] = 63 - c.joyY();
+				out[2] = c.whammyBar();
+				out[3] = c.touchbar();
+				return 4;
+			}
+			case(ExtensionType::DrumController): {
+				DrumController::Shared c(data);
+				out[0] = c.joyX();
+				out[1] = 63 - c.joyY();
+				return 2;
+			}
+			case(ExtensionType::DJTurntableController): {
+				DJTurntableController::Shared c(data);
+				out[0] = c.joyX();
+				out[1] = 63 - c.joyY();
+				out[2] = c.left.turntable();
+				out[3] = c.right.turntable();
+				out[4] = c.crossfadeSlider();
+				out[5] = c.effectDial();
+				return 6;
+			}
+			default:
+				return 0;
+		}
+	}
+
+	// Bridge
+	// --------------------
+	UinputBridge::UinputBridge(ExtensionController & p, UinputSink & s) :
+		port(p), sink(s) {}
+
+	UinputBridge::~UinputBridge() {
+		detach();
+	}
+
+	bool UinputBridge::attach() {
+		type = port.getControllerType();
+		remap.compile(type);
+
+		lastButtons = 0;  // A new device starts with everything released
+		for (int32_t & a : lastAxes) {
+			a = INT32_MIN;  // Send every axis on the first frame
+		}
+
+		attached = buildLayout(type, active) && sink.create(active);
+		if (attached) counters.plugs++;
+		return attached;
+	}
+
+	void UinputBridge::detach() {
+		if (attached) {
+			sink.destroy();
+			counters.unplugs++;
+		}
+		attached = false;
+		connected = false;
+		type = ExtensionType::NoController;
+	}
+
+	bool UinputBridge::poll() {
+		if (!connected) {
+			if (wait > 0) {
+				wait--;
+				return false;
+			}
+			if (!port.connect()) {
+				wait = reconnectPolls;
+				return false;
+			}
+			connected = true;
+			failures = 0;
+			attach();  // Unsupported types stay connected, without a device
+		}
+		else if (!port.update()) {
+			counters.failures++;
+			if (++failures >= FailureLimit) {
+				detach();  // Unplugged, or gone bad
+				wait = reconnectPolls;
+			}
+			return false;
+		}
+
+		failures = 0;
+		counters.frames++;
+		if (attached) {
+			send();
+		}
+		return true;
+	}
+
+	void UinputBridge::send() {
+		const uint64_t start = monotonicNs();
+		ExtensionController::ExtensionData & data = port.getExtensionData();
+
+		if (type == ExtensionType::ClassicController) {
+			ClassicController::Shared(data).fixNESKnockoffData();  // Before the buttons are mapped
+		}
+
+		struct input_event events[MaxEvents];
+		uint8_t n = 0;
+
+		const uint16_t buttons = remap.map(port);
+		for (uint16_t changed = buttons ^ lastButtons; changed != 0; changed &= changed - 1) {
+			const uint8_t bit = (uint8_t) __builtin_ctz(changed);
+			events[n] = {};
+			events[n].type = EV_KEY;
+			events[n].code = KeyCodes[bit];
+			events[n].value = (buttons >> bit) & 1;
+			n++;
+		}
+		lastButtons = buttons;
+
+		int32_t axes[UinputLayout::MaxAxes];
+		const uint8_t numAxes = readAxes(type, data, axes);
+		for (uint8_t i = 0; i < numAxes; i++) {
+			if (axes[i] == lastAxes[i]) continue;
+			events[n] = {};
+			events[n].type = EV_ABS;
+			events[n].code = active.axes[i].code;
+			events[n].value = axes[i];
+			lastAxes[i] = axes[i];
+			n++;
+		}
+
+		if (n == 0) return;  // Nothing changed, nothing sent
+
+		events[n] = {};
+		events[n].type = EV_SYN;
+		events[n].code = SYN_REPORT;
+
+		if (sink.emit(events, n + 1U)) {
+			counters.writes++;
+			counters.events += n;
+
+			const uint64_t latency = monotonicNs() - start;
+			counters.latencySumNs += latency;
+			if (latency > counters.latencyMaxNs) counters.latencyMaxNs = latency;
+		}
+	}
+}
@@ -0,0 +1,149 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Bridges a controller to Linux as an evdev gamepad through uinput. Buttons
+// go through the library's ButtonRemap onto the common virtual gamepad, and
+// from there to the standard gamepad key codes. Sticks, triggers and the
+// other analog controls become absolute axes. Each frame, only the keys and
+// axes that changed are sent, as one write() ending in SYN_REPORT.
+//
+// The device is created when a controller connects, with the keys and axes
+// of that controller type, and removed after several failed updates in a
+// row. Hot-plugging goes through the library's connect(). The device side is
+// a 'UinputSink', so a fake one can stand in for /dev/uinput when testing
+// without privileges (see sim/NXC_FakeUinput.h).
+
+#ifndef NXC_Uinput_h
+#define NXC_Uinput_h
+
+#include "internal/ExtensionController.h"
+#include "utility/NXC_Remap.h"
+
+struct input_event;
+
+namespace NXC_Host {
+	struct UinputAxis {
+		uint16_t code;  // ABS_*
+		int16_t min;
+		int16_t max;
+	};
+
+	// What one controller type looks like to evdev
+	struct UinputLayout {
+		static const uint8_t MaxKeys = 16;
+		static const uint8_t MaxAxes = 6;
+
+		const char * name;
+		uint16_t product;
+		uint16_t keys[MaxKeys];  // BTN_*
+		uint8_t numKeys;
+		UinputAxis axes[MaxAxes];
+		uint8_t numAxes;
+	};
+
+	class UinputSink {
+	public:
+		virtual ~UinputSink() {}
+
+		virtual bool create(const UinputLayout & layout) = 0;
+		virtual bool emit(const struct input_event * events, size_t count) = 0;  // One batch, ending in SYN_REPORT
+		virtual void destroy() = 0;
+		virtual bool isCreated() const = 0;
+	};
+
+	// The real thing, through /dev/uinput
+	class UinputDevice : public UinputSink {
+	public:
+		UinputDevice(const char * path = "/dev/uinput") : path(path) {}
+		~UinputDevice();
+
+		bool create(const UinputLayout & layout) override;
+		bool emit(const struct input_event * events, size_t count) override;
+		void destroy() override;
+		bool isCreated() const override { return fd >= 0; }
+
+		int lastError() const { return error; }
+
+	private:
+		bool fail();
+
+		const char * path;
+		int fd = -1;
+		int error = 0;
+	};
+
+	class UinputBridge {
+	public:
+		static const uint8_t FailureLimit = 8;  // Failed updates in a row before the device is removed
+		static const uint8_t MaxEvents = UinputLayout::MaxKeys + UinputLayout::MaxAxes + 1;
+
+		struct Stats {
+			uint32_t frames;       // Good frames read
+			uint32_t writes;       // Batches sent
+			uint32_t events;       // Key and axis events sent, not counting SYN_REPORT
+			uint32_t failures;     // Failed updates
+			uint32_t plugs;        // Devices created
+			uint32_t unplugs;      // Devices removed
+			uint64_t latencySumNs; // From the end of the bus read to the end of the write
+			uint64_t latencyMaxNs;
+		};
+
+		UinputBridge(ExtensionController & port, UinputSink & sink);
+		~UinputBridge();
+
+		bool poll();  // Connect or update, then send what changed. 'true' if a frame was read
+
+		void setReconnectInterval(uint32_t polls) { reconnectPolls = polls; }  // Polls between connect attempts
+		ExtensionType getType() const { return type; }
+		const Stats & stats() const { return counters; }
+
+		const UinputLayout * getLayout() const { return attached ? &active : nullptr; }
+
+		static bool buildLayout(ExtensionType type, UinputLayout & out);  // 'false' if unsupported. Keys follow the default remap profile
+		static uint8_t readAxes(ExtensionType type, ExtensionController::ExtensionData & data, int32_t * out);
+		static uint16_t keyCode(uint8_t virtualButton);  // Bit number in VirtualGamepad::Button
+
+	private:
+		bool attach();
+		void detach();
+		void send();
+
+		ExtensionController & port;
+		UinputSink & sink;
+		NintendoExtensionCtrl::ButtonRemap remap;
+
+		ExtensionType type = ExtensionType::NoController;
+		bool connected = false;
+		bool attached = false;  // Device created
+		UinputLayout active;
+		uint16_t lastButtons = 0;
+		int32_t lastAxes[UinputLayout::MaxAxes];
+
+		uint8_t failures = 0;
+		uint32_t reconnectPolls = 100;
+		uint32_t wait = 0;
+
+		Stats counters = {};
+	};
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Arduino.h"
+
+#include <atomic>
+#include <time.h>
+
+HostSerial Serial;
+
+namespace NXC_Host {
+	static bool realtime = false;
+	static std::atomic<uint64_t> simulated(0);  // Shared by the poll threads
+
+	void setRealtime(bool sleep) { realtime = sleep; }
+	bool isRealtime() { return realtime; }
+
+	void advanceTime(uint64_t us) { simulated.fetch_add(us, std::memory_order_relaxed); }
+	uint64_t simulatedTime() { return simulated.load(std::memory_order_relaxed); }
+
+	uint64_t nanos() {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	}
+
+	static void sleepMicros(uint64_t us) {
+		struct timespec ts;
+		ts.tv_sec = us / 1000000;
+		ts.tv_nsec = (us % 1000000) * 1000;
+		nanosleep(&ts, nullptr);
+	}
+}
+
+void delay(unsigned long ms) {
+	delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+	if (NXC_Host::realtime) {
+		NXC_Host::sleepMicros(us);
+	}
+	else {
+		NXC_Host::advanceTime(us);
+	}
+}
+
+unsigned long micros() {
+	return (unsigned long) (NXC_Host::nanos() / 1000 + NXC_Host::simulatedTime());
+}
+
+unsigned long millis() {
+	return micros() / 1000;
+}
+
+// Print
+// --------------------
+size_t Print::write(const uint8_t * buffer, size_t size) {
+	size_t n = 0;
+	while (size--) {
+		n += write(*buffer++);
+	}
+	return n;
+}
+
+size_t Print::write(const char * str) {
+	if (str == nullptr) return 0;
+	return write((const uint8_t *) str, strlen(str));
+}
+
+size_t Print::print(const char str[]) {
+	return write(str);
+}
+
+size_t Print::print(char c) {
+	return write((uint8_t) c);
+}
+
+size_t Print::print(long n, int base) {
+	if (base == DEC && n < 0) {
+		return print('-') + printNumber((unsigned long) -n, DEC);
+	}
+	return printNumber((unsigned long) n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+	return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+	return print(buffer);
+}
+
+size_t Print::println() {
+	return write("\r\n");
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+	char buffer[8 * sizeof(long) + 1];
+	char * str = &buffer[sizeof(buffer) - 1];
+	*str = '\0';
+
+	if (base < 2) base = 10;
+
+	do {
+		char c = n % base;
+		n /= base;
+		*--str = c < 10 ? c + '0' : c + 'A' - 10;
+	} while (n);
+
+	return write(str);
+}
+
+// Stream
+// --------------------
+size_t Stream::readBytes(uint8_t * buffer, size_t length) {
+	size_t count = 0;
+	while (count < length) {
+		int c = read();
+		if (c < 0) break;
+		*buffer++ = (uint8_t) c;
+		count++;
+	}
+	return count;
+}
+
+// Serial
+// --------------------
+size_t HostSerial::write(uint8_t c) {
+	if (!muted) fputc(c, stdout);
+	return 1;
+}
+
+size_t HostSerial::write(const uint8_t * buffer, size_t size) {
+	if (!muted) fwrite(buffer, 1, size, stdout);
+	return size;
+}
@@ -0,0 +1,137 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Minimal stand-in for the Arduino core, just enough to build the library
+// on a desktop host for benchmarking and simulation. Time spent in delay()
+// and delayMicroseconds() is simulated by default rather than slept, so
+// benchmarks measure the code and not the bus waits.
+
+#ifndef NXC_Host_Arduino_h
+#define NXC_Host_Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#ifndef PROGMEM
+#define PROGMEM  // Flash and RAM share an address space on the host
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define memcpy_P memcpy
+#endif
+
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long millis();
+unsigned long micros();
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+namespace NXC_Host {
+	// Host timekeeping. micros() is the real monotonic time plus any
+	// simulated delays. With 'realtime' set, delays sleep instead.
+	void setRealtime(bool sleep);
+	bool isRealtime();
+
+	void advanceTime(uint64_t us);  // Add simulated time
+	uint64_t simulatedTime();        // Total simulated time, in microseconds
+	uint64_t nanos();                // Real monotonic time, in nanoseconds
+}
+
+class Print {
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t * buffer, size_t size);
+	virtual int availableForWrite() { return 0; }
+
+	size_t write(const char * str);
+	size_t write(const char * buffer, size_t size) { return write((const uint8_t *) buffer, size); }
+
+	size_t print(const char str[]);
+	size_t print(char c);
+	size_t print(unsigned char n, int base = DEC) { return print((unsigned long) n, base); }
+	size_t print(int n, int base = DEC) { return print((long) n, base); }
+	size_t print(unsigned int n, int base = DEC) { return print((unsigned long) n, base); }
+	size_t print(long n, int base = DEC);
+	size_t print(unsigned long n, int base = DEC);
+	size_t print(double n, int digits = 2);
+
+	size_t println();
+	template<typename T>
+	size_t println(T value) { size_t n = print(value); return n + println(); }
+	template<typename T>
+	size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+private:
+	size_t printNumber(unsigned long n, uint8_t base);
+};
+
+class Stream : public Print {
+public:
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() = 0;
+
+	size_t readBytes(uint8_t * buffer, size_t length);
+	size_t readBytes(char * buffer, size_t length) { return readBytes((uint8_t *) buffer, length); }
+};
+
+// Serial output goes to stdout, and can be muted for benchmarks
+class HostSerial : public Stream {
+public:
+	void begin(unsigned long) {}
+	size_t write(uint8_t c) override;
+	size_t write(const uint8_t * buffer, size_t size) override;
+	using Print::write;
+	int availableForWrite() override { return 64; }
+
+	int available() override { return 0; }
+	int read() override { return -1; }
+	int peek() override { return -1; }
+
+	void mute(bool m) { muted = m; }
+	operator bool() const { return true; }
+
+private:
+	bool muted = false;
+};
+
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,133 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Wire.h"
+
+namespace NXC_Host {
+	bool SimulatedBus::attach(uint8_t addr, I2CDevice & dev) {
+		for (Slot & s : slots) {
+			if (s.device == nullptr || s.addr == addr) {
+				s.addr = addr;
+				s.device = &dev;
+				return true;
+			}
+		}
+		return false;  // No room
+	}
+
+	void SimulatedBus::detach(uint8_t addr) {
+		for (Slot & s : slots) {
+			if (s.device != nullptr && s.addr == addr) {
+				s.device = nullptr;
+			}
+		}
+	}
+
+	I2CDevice * SimulatedBus::device(uint8_t addr) const {
+		for (const Slot & s : slots) {
+			if (s.device != nullptr && s.addr == addr) {
+				return s.device;
+			}
+		}
+		return nullptr;
+	}
+
+	uint8_t SimulatedBus::write(uint8_t addr, const uint8_t * data, size_t length) {
+		I2CDevice * dev = device(addr);
+		if (dev == nullptr) return I2C_AddrNACK;
+		return dev->receive(data, length) ? I2C_OK : I2C_DataNACK;
+	}
+
+	size_t SimulatedBus::read(uint8_t addr, uint8_t * data, size_t length) {
+		I2CDevice * dev = device(addr);
+		if (dev == nullptr) return 0;
+		return dev->transmit(data, length);
+	}
+
+	SimulatedBus & defaultBus() {
+		static SimulatedBus bus;
+		return bus;
+	}
+}
+
+TwoWire Wire(NXC_Host::defaultBus());
+
+TwoWire::TwoWire(NXC_Host::I2CBus & backend) : bus(&backend) {}
+
+void TwoWire::begin() {
+	bus->begin();
+}
+
+void TwoWire::setClock(uint32_t hz) {
+	bus->setClock(hz);
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+	transmitting = true;
+	txAddress = address;
+	txLength = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+	(void) sendStop;
+	transmitting = false;
+	return bus->write(txAddress, txBuffer, txLength);
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+	(void) sendStop;
+	if (quantity > BufferLength) {
+		quantity = BufferLength;
+	}
+
+	rxIndex = 0;
+	rxLength = (uint8_t) bus->read(address, rxBuffer, quantity);
+	return rxLength;
+}
+
+size_t TwoWire::write(uint8_t data) {
+	if (!transmitting || txLength >= BufferLength) {
+		return 0;
+	}
+	txBuffer[txLength++] = data;
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t * data, size_t quantity) {
+	size_t n = 0;
+	while (quantity-- && write(*data++)) {
+		n++;
+	}
+	return n;
+}
+
+int TwoWire::available() {
+	return rxLength - rxIndex;
+}
+
+int TwoWire::read() {
+	return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1;
+}
+
+int TwoWire::peek() {
+	return rxIndex < rxLength ? rxBuffer[rxIndex] : -1;
+}
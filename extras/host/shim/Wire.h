@@ -0,0 +1,127 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Host stand-in for the Arduino 'Wire' library. Transactions are buffered
+// the same way as the real TwoWire class, then handed off to an 'I2CBus'
+// backend. By default that's the simulated bus, with devices attached by
+// address.
+
+#ifndef NXC_Host_Wire_h
+#define NXC_Host_Wire_h
+
+#include "Arduino.h"
+
+namespace NXC_Host {
+	// Result codes match TwoWire::endTransmission()
+	enum I2CStatus : uint8_t {
+		I2C_OK = 0,
+		I2C_TooLong = 1,
+		I2C_AddrNACK = 2,
+		I2C_DataNACK = 3,
+		I2C_Error = 4,
+	};
+
+	// Bus backend, one complete transaction per call
+	class I2CBus {
+	public:
+		virtual ~I2CBus() {}
+
+		virtual void begin() {}
+		virtual void setClock(uint32_t hz) { (void) hz; }
+
+		virtual uint8_t write(uint8_t addr, const uint8_t * data, size_t length) = 0;  // I2CStatus
+		virtual size_t read(uint8_t addr, uint8_t * data, size_t length) = 0;  // Bytes received
+	};
+
+	// A device on the simulated bus
+	class I2CDevice {
+	public:
+		virtual ~I2CDevice() {}
+
+		virtual bool receive(const uint8_t * data, size_t length) = 0;  // 'false' to NACK
+		virtual size_t transmit(uint8_t * data, size_t length) = 0;     // Bytes sent
+	};
+
+	class SimulatedBus : public I2CBus {
+	public:
+		static const uint8_t MaxDevices = 8;
+
+		bool attach(uint8_t addr, I2CDevice & device);
+		void detach(uint8_t addr);
+		I2CDevice * device(uint8_t addr) const;
+
+		uint8_t write(uint8_t addr, const uint8_t * data, size_t length) override;
+		size_t read(uint8_t addr, uint8_t * data, size_t length) override;
+
+	private:
+		struct Slot {
+			uint8_t addr;
+			I2CDevice * device;
+		} slots[MaxDevices] = {};
+	};
+
+	SimulatedBus & defaultBus();  // The bus behind the global 'Wire'
+}
+
+class TwoWire : public Stream {
+public:
+	static const uint8_t BufferLength = 32;
+
+	TwoWire(NXC_Host::I2CBus & backend);
+
+	void begin();
+	void setClock(uint32_t hz);
+
+	void beginTransmission(uint8_t address);
+	void beginTransmission(int address) { beginTransmission((uint8_t) address); }
+	uint8_t endTransmission(bool sendStop = true);
+
+	uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+	uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t) address, (uint8_t) quantity); }
+
+	size_t write(uint8_t data) override;
+	size_t write(const uint8_t * data, size_t quantity) override;
+	using Print::write;
+
+	int available() override;
+	int read() override;
+	int peek() override;
+
+	NXC_Host::I2CBus & backend() const { return *bus; }
+	void setBackend(NXC_Host::I2CBus & backend) { bus = &backend; }
+
+private:
+	NXC_Host::I2CBus * bus;
+
+	uint8_t txAddress = 0;
+	uint8_t txBuffer[BufferLength];
+	uint8_t txLength = 0;
+	bool transmitting = false;
+
+	uint8_t rxBuffer[BufferLength];
+	uint8_t rxIndex = 0;
+	uint8_t rxLength = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
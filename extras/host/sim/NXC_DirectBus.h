@@ -0,0 +1,88 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_DirectBus_h
+#define NXC_DirectBus_h
+
+#include "Arduino.h"
+#include "NXC_SimController.h"
+
+namespace NXC_Host {
+	// Mock bus with the Wire interface, wired straight to one simulated
+	// controller. Nothing is virtual and there's no backend in between, so a
+	// port built on it with the transport policy shows what the library's
+	// own transaction code costs.
+	class DirectBus {
+	public:
+		static const uint8_t BufferLength = 32;
+
+		DirectBus(SimulatedController & device) : controller(device) {}
+
+		void begin() {}
+
+		void beginTransmission(uint8_t address) {
+			txAddress = address;
+			txLength = 0;
+		}
+
+		size_t write(uint8_t data) {
+			if (txLength >= BufferLength) return 0;
+			txBuffer[txLength++] = data;
+			return 1;
+		}
+
+		uint8_t endTransmission() {
+			if (txAddress != SimulatedController::Address) return I2C_AddrNACK;
+			return controller.SimulatedController::receive(txBuffer, txLength) ? I2C_OK : I2C_DataNACK;
+		}
+
+		uint8_t requestFrom(uint8_t address, uint8_t quantity) {
+			rxIndex = 0;
+			rxLength = 0;
+			if (address != SimulatedController::Address) return 0;
+			if (quantity > BufferLength) quantity = BufferLength;
+			rxLength = controller.SimulatedController::transmit(rxBuffer, quantity);
+			return rxLength;
+		}
+
+		size_t readBytes(uint8_t * buffer, size_t length) {
+			size_t n = 0;
+			while (n < length && rxIndex < rxLength) {
+				buffer[n++] = rxBuffer[rxIndex++];
+			}
+			return n;
+		}
+
+	private:
+		SimulatedController & controller;
+
+		uint8_t txAddress = 0;
+		uint8_t txBuffer[BufferLength];
+		uint8_t txLength = 0;
+
+		uint8_t rxBuffer[BufferLength];
+		uint8_t rxIndex = 0;
+		uint8_t rxLength = 0;
+	};
+}
+
+#endif
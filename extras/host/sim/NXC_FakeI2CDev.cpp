@@ -0,0 +1,147 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_FakeI2CDev.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+namespace NXC_Host {
+	bool FakeI2CDev::transferRead(uint8_t addr, uint8_t * data, size_t length) {
+		size_t n = 0;
+		if (now() < readyAt) {
+			early++;  // Not converted yet
+		}
+		else {
+			n = bus.read(addr, data, length);
+		}
+		if (n < length) {
+			memset(data + n, 0xFF, length - n);  // Nobody driving the bus
+		}
+		return true;
+	}
+
+	bool FakeI2CDev::transferWrite(uint8_t addr, const uint8_t * data, size_t length) {
+		if (bus.write(addr, data, length) != I2C_OK) return false;
+		if (length == 1) {
+			readyAt = now() + conversionNs;
+		}
+		return true;
+	}
+
+	int FakeI2CDev::open(const char * path, int flags) {
+		count.open++;
+		if (opened) {
+			errno = EBUSY;
+			return -1;
+		}
+		opened = true;
+		slave = -1;
+		return FakeFd;
+	}
+
+	int FakeI2CDev::close(int fd) {
+		count.close++;
+		if (!opened || fd != FakeFd) {
+			errno = EBADF;
+			return -1;
+		}
+		opened = false;
+		return 0;
+	}
+
+	int FakeI2CDev::ioctl(int fd, unsigned long request, void * arg) {
+		count.ioctl++;
+		if (!opened || fd != FakeFd) {
+			errno = EBADF;
+			return -1;
+		}
+
+		if (request == I2C_SLAVE) {
+			slave = (int16_t) (uintptr_t) arg;
+			return 0;
+		}
+		else if (request == I2C_RDWR) {
+			const struct i2c_rdwr_ioctl_data * rdwr = (const struct i2c_rdwr_ioctl_data *) arg;
+			if (rdwr->nmsgs == 0 || rdwr->nmsgs > I2C_RDWR_IOCTL_MAX_MSGS) {
+				errno = EINVAL;
+				return -1;
+			}
+
+			for (uint32_t i = 0; i < rdwr->nmsgs; i++) {
+				const struct i2c_msg & msg = rdwr->msgs[i];
+				if (msg.flags & I2C_M_RD) {
+					transferRead((uint8_t) msg.addr, msg.buf, msg.len);
+				}
+				else if (!transferWrite((uint8_t) msg.addr, msg.buf, msg.len)) {
+					errno = ENXIO;
+					return -1;
+				}
+			}
+			return (int) rdwr->nmsgs;
+		}
+
+		errno = ENOTTY;
+		return -1;
+	}
+
+	ssize_t FakeI2CDev::read(int fd, void * buf, size_t count) {
+		this->count.read++;
+		if (!opened || fd != FakeFd || slave < 0) {
+			errno = opened ? EINVAL : EBADF;
+			return -1;
+		}
+
+		transferRead((uint8_t) slave, (uint8_t *) buf, count);
+		return (ssize_t) count;
+	}
+
+	ssize_t FakeI2CDev::write(int fd, const void * buf, size_t count) {
+		this->count.write++;
+		if (!opened || fd != FakeFd || slave < 0) {
+			errno = opened ? EINVAL : EBADF;
+			return -1;
+		}
+
+		if (!transferWrite((uint8_t) slave, (const uint8_t *) buf, count)) {
+			errno = EREMOTEIO;
+			return -1;
+		}
+		return (ssize_t) count;
+	}
+
+	uint64_t FakeI2CDev::now() {
+		return nanos() + slept;
+	}
+
+	int FakeI2CDev::sleepUntil(uint64_t deadline) {
+		count.sleep++;
+		const uint64_t t = now();
+		if (deadline > t) {
+			slept += deadline - t;
+		}
+		return 0;
+	}
+}
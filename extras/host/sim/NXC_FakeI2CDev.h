@@ -0,0 +1,84 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_FakeI2CDev_h
+#define NXC_FakeI2CDev_h
+
+#include "NXC_LinuxI2C.h"
+
+namespace NXC_Host {
+	// Stand-in for the kernel's i2c-dev, for testing LinuxI2CBus without
+	// hardware. Transfers go to another bus backend (e.g. a SimulatedBus with
+	// a controller attached), and every call is counted. I2C_RDWR messages
+	// run in order and stop at the first NACK, as the kernel does. Sleeps
+	// don't sleep: they move a fake clock forward, which now() includes. With a
+	// conversion time set, reads that come too soon after a pointer write are
+	// counted and get 0xFF data, like the real controller.
+	class FakeI2CDev : public I2CDevSyscalls {
+	public:
+		struct Calls {
+			uint32_t open;
+			uint32_t close;
+			uint32_t ioctl;
+			uint32_t read;
+			uint32_t write;
+			uint32_t sleep;
+		};
+
+		static const int FakeFd = 3;
+
+		FakeI2CDev(I2CBus & target) : bus(target) {}
+
+		int open(const char * path, int flags) override;
+		int close(int fd) override;
+		int ioctl(int fd, unsigned long request, void * arg) override;
+		ssize_t read(int fd, void * buf, size_t count) override;
+		ssize_t write(int fd, const void * buf, size_t count) override;
+
+		uint64_t now() override;
+		int sleepUntil(uint64_t deadline) override;
+
+		void setConversionTime(uint32_t us) { conversionNs = (uint64_t) us * 1000; }
+		uint32_t earlyReads() const { return early; }
+
+		const Calls & calls() const { return count; }
+		uint32_t syscalls() const { return count.ioctl + count.read + count.write; }
+		uint64_t sleptNs() const { return slept; }  // Fake time added by sleeps
+		void resetCalls() { count = {}; early = 0; }
+
+	private:
+		bool transferRead(uint8_t addr, uint8_t * data, size_t length);
+		bool transferWrite(uint8_t addr, const uint8_t * data, size_t length);
+
+		I2CBus & bus;
+		bool opened = false;
+		int16_t slave = -1;  // Address set with I2C_SLAVE
+
+		uint64_t slept = 0;
+		uint64_t conversionNs = 0;
+		uint64_t readyAt = 0;  // Fake time the last pointer write's data is ready
+		uint32_t early = 0;
+		Calls count = {};
+	};
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_FakeUinput.h"
+
+#include <linux/input.h>
+
+namespace NXC_Host {
+	bool FakeUinputSink::create(const UinputLayout & l) {
+		if (created) bad++;  // Should have been destroyed first
+
+		layout = l;
+		created = true;
+		creates++;
+
+		for (int32_t & k : keyState) k = 0;
+		for (int32_t & a : axisState) a = 0;
+		return true;
+	}
+
+	void FakeUinputSink::destroy() {
+		created = false;
+	}
+
+	int FakeUinputSink::keyIndex(uint16_t code) const {
+		for (uint8_t i = 0; i < layout.numKeys; i++) {
+			if (layout.keys[i] == code) return i;
+		}
+		return -1;
+	}
+
+	int FakeUinputSink::axisIndex(uint16_t code) const {
+		for (uint8_t i = 0; i < layout.numAxes; i++) {
+			if (layout.axes[i].code == code) return i;
+		}
+		return -1;
+	}
+
+	bool FakeUinputSink::emit(const struct input_event * events, size_t count) {
+		if (!created || count < 2) {
+			bad++;
+			return false;
+		}
+
+		batches++;
+		for (size_t i = 0; i < count; i++) {
+			const struct input_event & e = events[i];
+			const bool last = (i == count - 1);
+
+			if (e.type == EV_SYN) {
+				if (!last || e.code != SYN_REPORT) bad++;
+				continue;
+			}
+			if (last) bad++;  // Missing SYN_REPORT
+			total++;
+
+			if (e.type == EV_KEY) {
+				const int k = keyIndex(e.code);
+				if (k < 0 || keyState[k] == e.value || (e.value != 0 && e.value != 1)) bad++;
+				else keyState[k] = e.value;
+			}
+			else if (e.type == EV_ABS) {
+				const int a = axisIndex(e.code);
+				if (a < 0 || e.value < layout.axes[a].min || e.value > layout.axes[a].max) bad++;
+				else axisState[a] = e.value;
+			}
+			else {
+				bad++;
+			}
+		}
+		return true;
+	}
+
+	int32_t FakeUinputSink::key(uint16_t code) const {
+		const int k = created ? keyIndex(code) : -1;
+		return k >= 0 ? keyState[k] : -1;
+	}
+
+	int32_t FakeUinputSink::axis(uint16_t code) const {
+		const int a = created ? axisIndex(code) : -1;
+		return a >= 0 ? axisState[a] : INT32_MIN;
+	}
+}
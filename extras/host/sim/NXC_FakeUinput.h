@@ -0,0 +1,65 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_FakeUinput_h
+#define NXC_FakeUinput_h
+
+#include "NXC_Uinput.h"
+
+namespace NXC_Host {
+	// Stand-in for /dev/uinput that keeps the device state the kernel would,
+	// so a test can compare it against the controller. Every batch is checked:
+	// it must end in SYN_REPORT, only use codes the device was created with,
+	// and only carry values that changed. Anything else counts as an error.
+	class FakeUinputSink : public UinputSink {
+	public:
+		bool create(const UinputLayout & layout) override;
+		bool emit(const struct input_event * events, size_t count) override;
+		void destroy() override;
+		bool isCreated() const override { return created; }
+
+		int32_t key(uint16_t code) const;   // -1 if the device doesn't have it
+		int32_t axis(uint16_t code) const;  // INT32_MIN if the device doesn't have it
+
+		const char * name() const { return created ? layout.name : nullptr; }
+		uint32_t devicesCreated() const { return creates; }
+		uint32_t writes() const { return batches; }
+		uint32_t events() const { return total; }
+		uint32_t errors() const { return bad; }
+
+	private:
+		int keyIndex(uint16_t code) const;
+		int axisIndex(uint16_t code) const;
+
+		bool created = false;
+		UinputLayout layout = {};
+		int32_t keyState[UinputLayout::MaxKeys];
+		int32_t axisState[UinputLayout::MaxAxes];
+
+		uint32_t creates = 0;
+		uint32_t batches = 0;
+		uint32_t total = 0;
+		uint32_t bad = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,137 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_MockI2CT3.h"
+
+using namespace NXC_Host;
+
+i2c_t3::i2c_t3(I2CBus & backend, uint32_t clockHz) : bus(backend) {
+	setClock(clockHz);
+}
+
+void i2c_t3::setClock(uint32_t hz) {
+	clock = hz > 0 ? hz : 100000;
+	bus.setClock(clock);
+}
+
+double i2c_t3::transferTime(size_t bytes) const {
+	const double bitUs = 1000000.0 / clock;
+	return (9.0 * (bytes + 1) + 2.0) * bitUs;  // Address + data, 9 bits each, plus start/stop
+}
+
+void i2c_t3::schedule(size_t bytes) {
+	const double start = doneAt > now() ? doneAt : now();
+	const double duration = transferTime(bytes);
+	doneAt = start + duration;
+	busyUs += duration;
+	count++;
+}
+
+void i2c_t3::wait() {
+	if (stuck) return;  // Would wait forever, i2c_t3 with no timeout set
+
+	const double t = now();
+	if (doneAt > t) {
+		advanceTime((uint64_t) ceil(doneAt - t));
+	}
+}
+
+void i2c_t3::beginTransmission(uint8_t address) {
+	txAddress = address;
+	txLength = 0;
+}
+
+size_t i2c_t3::write(uint8_t data) {
+	if (txLength >= BufferLength) return 0;
+	txBuffer[txLength++] = data;
+	return 1;
+}
+
+size_t i2c_t3::write(const uint8_t * data, size_t quantity) {
+	size_t n = 0;
+	while (n < quantity && write(data[n])) n++;
+	return n;
+}
+
+void i2c_t3::sendTransmission() {
+	error = bus.write(txAddress, txBuffer, txLength);
+	schedule(error == I2C_AddrNACK ? 0 : txLength);
+	pointerDoneAt = (error == I2C_OK && txLength == 1) ? doneAt : -1.0;
+}
+
+uint8_t i2c_t3::endTransmission() {
+	sendTransmission();
+	wait();
+	return error;
+}
+
+void i2c_t3::sendRequest(uint8_t address, size_t length) {
+	if (length > BufferLength) length = BufferLength;
+
+	const double start = doneAt > now() ? doneAt : now();
+	const bool ready = pointerDoneAt >= 0.0 && start - pointerDoneAt >= conversionUs;
+	pointerDoneAt = -1.0;
+
+	rxIndex = 0;
+	rxLength = (uint8_t) bus.read(address, rxBuffer, length);
+	if (rxLength > 0 && !ready && conversionUs > 0) {
+		memset(rxBuffer, 0xFF, rxLength);  // Read too soon, the controller isn't ready
+		early++;
+	}
+
+	error = rxLength > 0 ? I2C_OK : I2C_AddrNACK;
+	schedule(rxLength);
+}
+
+size_t i2c_t3::requestFrom(uint8_t address, size_t length) {
+	sendRequest(address, length);
+	wait();
+	return rxLength;
+}
+
+uint8_t i2c_t3::done() {
+	return !stuck && now() >= doneAt ? 1 : 0;
+}
+
+uint8_t i2c_t3::finish() {
+	wait();
+	return error == I2C_OK ? 1 : 0;
+}
+
+uint8_t i2c_t3::getError() {
+	return error;
+}
+
+int i2c_t3::available() {
+	if (!done()) return 0;
+	return rxLength - rxIndex;
+}
+
+int i2c_t3::read() {
+	if (available() <= 0) return -1;
+	return rxBuffer[rxIndex++];
+}
+
+int i2c_t3::peek() {
+	if (available() <= 0) return -1;
+	return rxBuffer[rxIndex];
+}
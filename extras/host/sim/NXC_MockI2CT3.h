@@ -0,0 +1,102 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_MockI2CT3_h
+#define NXC_MockI2CT3_h
+
+#include "Arduino.h"
+#include "Wire.h"
+
+// Host stand-in for the parts of Teensy's i2c_t3 library that the library
+// uses, blocking and non-blocking. Each instance is its own hardware bus
+// with its own timeline. sendTransmission() and sendRequest() start a
+// transfer and return, and done() turns true once micros() passes the
+// transfer's end, so transfers on separate instances overlap. The blocking
+// calls start a transfer and advance the simulated clock to its end. Data
+// goes through an 'I2CBus' backend when the transfer starts, but a read's
+// bytes aren't available until it's done. Transfer times use the same
+// model as TimedBus, and so does the conversion time: a read started too
+// soon after a pointer write gets 0xFF data.
+class i2c_t3 : public Stream {
+public:
+	static const uint8_t BufferLength = 32;
+
+	i2c_t3(NXC_Host::I2CBus & backend, uint32_t clockHz = 400000);
+
+	void begin() { bus.begin(); }
+	void setClock(uint32_t hz);
+
+	void beginTransmission(uint8_t address);
+	size_t write(uint8_t data) override;
+	size_t write(const uint8_t * data, size_t quantity) override;
+	using Print::write;
+
+	uint8_t endTransmission();    // Blocking, returns the error code
+	void sendTransmission();      // Non-blocking
+
+	size_t requestFrom(uint8_t address, size_t length);  // Blocking, returns the bytes received
+	void sendRequest(uint8_t address, size_t length);    // Non-blocking
+
+	uint8_t done();      // 1 once the last transfer is over
+	uint8_t finish();    // Waits for the last transfer, 1 if it succeeded
+	uint8_t getError();  // Error code of the last transfer, 0 for none
+
+	int available() override;  // 0 until a read is done
+	int read() override;
+	int peek() override;
+
+	void setConversionTime(uint32_t us) { conversionUs = us; }
+	void setStuck(bool s) { stuck = s; }  // Transfers never finish, like a slave holding SDA low
+
+	uint32_t transfers() const { return count; }
+	uint32_t earlyReads() const { return early; }  // Reads started before the data was ready
+	double busyTime() const { return busyUs; }     // Total time spent transferring, in us
+
+private:
+	double now() const { return (double) micros(); }
+	double transferTime(size_t bytes) const;
+	void schedule(size_t bytes);  // Queue a transfer behind the current one
+	void wait();                  // Advance the clock to the end of the transfer
+
+	NXC_Host::I2CBus & bus;
+	uint32_t clock;
+	uint32_t conversionUs = 0;  // Off, like TimedBus
+
+	uint8_t txAddress = 0;
+	uint8_t txBuffer[BufferLength];
+	uint8_t txLength = 0;
+
+	uint8_t rxBuffer[BufferLength];
+	uint8_t rxIndex = 0;
+	uint8_t rxLength = 0;
+
+	double doneAt = 0.0;          // When the current transfer ends
+	double pointerDoneAt = -1.0;  // When the last pointer write ended, -1 for none
+	uint8_t error = 0;
+	bool stuck = false;
+
+	uint32_t count = 0;
+	uint32_t early = 0;
+	double busyUs = 0.0;
+};
+
+#endif
@@ -0,0 +1,157 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Replay.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace NintendoExtensionCtrl;
+
+namespace NXC_Host {
+	bool CaptureFile::open(const char * path) {
+		close();
+
+		const int fd = ::open(path, O_RDONLY);
+		if (fd < 0) {
+			errorText = "could not open file";
+			return false;
+		}
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || (size_t) st.st_size < Capture::HeaderSize) {
+			::close(fd);
+			errorText = "file too small for a capture header";
+			return false;
+		}
+
+		void * m = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);  // The mapping holds its own reference
+		if (m == MAP_FAILED) {
+			errorText = "mmap failed";
+			return false;
+		}
+
+		map = (const uint8_t *) m;
+		mapSize = (size_t) st.st_size;
+
+		if (!Capture::validHeader(header())) {
+			close();
+			errorText = "not a capture, or unsupported version";
+			return false;
+		}
+
+		count = (mapSize - Capture::HeaderSize) / header().stride;  // Partial last record ignored
+		madvise(m, mapSize, MADV_SEQUENTIAL);
+		errorText = nullptr;
+		return true;
+	}
+
+	void CaptureFile::close() {
+		if (map != nullptr) {
+			munmap((void *) map, mapSize);
+		}
+		map = nullptr;
+		mapSize = 0;
+		count = 0;
+	}
+
+	uint32_t CaptureFile::duration() const {
+		return count != 0 ? Capture::recordTime(record(count - 1)) : 0;
+	}
+
+	ReplayController::ReplayController(const CaptureFile & capture, Mode m)
+		: SimulatedController(capture.type()), file(capture), mode(m)
+	{
+		setID(capture.header().id);
+		rewind();
+	}
+
+	void ReplayController::rewind() {
+		next = 0;
+		started = false;
+		done = false;
+		loopCount = 0;
+		if (file.records() != 0) {
+			load(0);  // Seen by reads before the replay starts, e.g. on connect
+		}
+	}
+
+	void ReplayController::load(uint64_t n) {
+		setControlData(Capture::recordData(file.record(n)), file.requestSize());
+	}
+
+	void ReplayController::advance() {
+		const uint64_t count = file.records();
+		if (count == 0 || done) return;
+
+		if (mode == Mode::FullSpeed) {
+			if (next == count) {
+				if (!loop) {
+					done = true;
+					return;
+				}
+				next = 0;
+				loopCount++;
+			}
+			load(next++);
+			return;
+		}
+
+		// Real time, serve the latest record that's due
+		const unsigned long now = micros();
+		if (!started) {
+			started = true;
+			startTime = now;
+		}
+
+		uint32_t elapsed = (uint32_t) (now - startTime);
+		if (next == count && elapsed > file.duration()) {
+			if (!loop) {
+				done = true;
+				return;
+			}
+			next = 0;
+			loopCount++;
+			startTime = now;
+			elapsed = 0;
+		}
+
+		uint64_t due = next;
+		while (due < count && Capture::recordTime(file.record(due)) <= elapsed) {
+			due++;
+		}
+		if (due != next) {
+			load(due - 1);
+			next = due;
+		}
+	}
+
+	size_t ReplayController::transmit(uint8_t * data, size_t length) {
+		if (initialized() && pointer == ControlDataStart) {
+			advance();
+		}
+		return SimulatedController::transmit(data, length);
+	}
+}
@@ -0,0 +1,110 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Replay_h
+#define NXC_Replay_h
+
+#include "NXC_SimController.h"
+#include "utility/NXC_Capture.h"
+
+namespace NXC_Host {
+	// Read-only, memory-mapped capture file (see 'NXC_Capture.h' for the
+	// format). Records are read in place, so captures of any size open
+	// instantly and are paged in as they're replayed.
+	class CaptureFile {
+	public:
+		CaptureFile() {}
+		~CaptureFile() { close(); }
+
+		CaptureFile(const CaptureFile &) = delete;
+		CaptureFile & operator=(const CaptureFile &) = delete;
+
+		bool open(const char * path);  // 'false' with 'error()' set on failure
+		void close();
+
+		bool isOpen() const { return map != nullptr; }
+		const char * error() const { return errorText; }
+
+		const NintendoExtensionCtrl::Capture::Header & header() const { return *(const NintendoExtensionCtrl::Capture::Header *) map; }
+		ExtensionType type() const { return (ExtensionType) header().type; }
+		uint8_t requestSize() const { return header().requestSize; }
+
+		uint64_t records() const { return count; }
+		uint64_t bytes() const { return mapSize; }
+		const uint8_t * record(uint64_t n) const {
+			return map + NintendoExtensionCtrl::Capture::HeaderSize + n * header().stride;
+		}
+
+		uint32_t duration() const;  // Timestamp of the last record, in us
+
+	private:
+		const uint8_t * map = nullptr;
+		size_t mapSize = 0;
+		uint64_t count = 0;
+		const char * errorText = nullptr;
+	};
+
+	// Simulated controller that plays back a capture. It reports the captured
+	// ID, and each control data read (pointer at 0x00) is served from the
+	// capture, so the library's update() path and every controller class see
+	// the recorded data as live input.
+	//
+	// At full speed every read gets the next record. In real time, reads get
+	// the latest record that's due based on micros() since the replay started,
+	// so a poll loop faster or slower than the original sees what it would
+	// have seen live.
+	class ReplayController : public SimulatedController {
+	public:
+		enum class Mode : uint8_t {
+			FullSpeed,
+			RealTime,
+		};
+
+		ReplayController(const CaptureFile & capture, Mode mode = Mode::FullSpeed);
+
+		void setMode(Mode m) { mode = m; }
+		void setLoop(bool enable) { loop = enable; }  // Start over at the end
+		void rewind();
+
+		bool finished() const { return done; }  // Past the last record, with looping off
+		uint64_t position() const { return next; }  // Records served
+		uint32_t loops() const { return loopCount; }
+
+		size_t transmit(uint8_t * data, size_t length) override;
+
+	private:
+		void advance();
+		void load(uint64_t n);
+
+		const CaptureFile & file;
+		Mode mode;
+		bool loop = false;
+
+		uint64_t next = 0;  // Next record to serve
+		bool started = false;
+		unsigned long startTime = 0;  // micros() at the first read, for real time
+		bool done = false;
+		uint32_t loopCount = 0;
+	};
+}
+
+#endif
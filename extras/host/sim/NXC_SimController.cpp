@@ -0,0 +1,106 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_SimController.h"
+
+namespace NXC_Host {
+	namespace {
+		struct SimProfile {
+			ExtensionType type;
+			uint8_t id[6];
+			uint8_t controlData[6];  // At rest
+		};
+
+		const SimProfile Profiles[] = {
+			{ ExtensionType::Nunchuk,               { 0x00, 0x00, 0xA4, 0x20, 0x00, 0x00 }, { 0x80, 0x80, 0x80, 0x80, 0xB3, 0x57 } },
+			{ ExtensionType::ClassicController,     { 0x00, 0x00, 0xA4, 0x20, 0x01, 0x01 }, { 0x5F, 0xDF, 0x8F, 0x00, 0xFF, 0xFF } },
+			{ ExtensionType::GuitarController,      { 0x00, 0x00, 0xA4, 0x20, 0x01, 0x03 }, { 0xE0, 0xE0, 0xEF, 0xF0, 0xFF, 0xFF } },
+			{ ExtensionType::DrumController,        { 0x01, 0x00, 0xA4, 0x20, 0x01, 0x03 }, { 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF } },
+			{ ExtensionType::DJTurntableController, { 0x03, 0x00, 0xA4, 0x20, 0x01, 0x03 }, { 0x20, 0x20, 0x10, 0x00, 0xFE, 0xFF } },
+		};
+	}
+
+	SimulatedController::SimulatedController(ExtensionType type) {
+		memset(registers, 0x00, sizeof(registers));
+		setType(type);
+	}
+
+	void SimulatedController::setType(ExtensionType type) {
+		for (const SimProfile & p : Profiles) {
+			if (p.type == type) {
+				memset(registers, 0x00, IdentityStart);
+				setID(p.id);
+				setControlData(p.controlData, sizeof(p.controlData));
+				return;
+			}
+		}
+
+		// Unknown, random-ish ID and no useful data
+		const uint8_t unknownID[6] = { 0x12, 0x34, 0xA4, 0x20, 0x56, 0x78 };
+		setID(unknownID);
+	}
+
+	void SimulatedController::setID(const uint8_t * id) {
+		memcpy(&registers[IdentityStart], id, 6);
+	}
+
+	void SimulatedController::setControlData(uint8_t index, uint8_t value) {
+		registers[ControlDataStart + index] = value;
+	}
+
+	void SimulatedController::setControlData(const uint8_t * data, size_t size) {
+		memcpy(&registers[ControlDataStart], data, size);
+	}
+
+	void SimulatedController::reset() {
+		init = false;
+		initStep1 = false;
+		pointer = 0;
+	}
+
+	bool SimulatedController::receive(const uint8_t * data, size_t length) {
+		writes++;
+		if (length == 0) return true;  // Address probe
+
+		pointer = data[0];
+
+		if (length >= 2) {
+			// Register write, the only ones handled are the init sequence
+			if (pointer == 0xF0 && data[1] == 0x55) {
+				initStep1 = true;
+			}
+			else if (pointer == 0xFB && data[1] == 0x00 && initStep1) {
+				init = true;
+			}
+		}
+		return true;
+	}
+
+	size_t SimulatedController::transmit(uint8_t * data, size_t length) {
+		reads++;
+		for (size_t i = 0; i < length; i++) {
+			data[i] = init ? registers[pointer] : 0xFF;
+			pointer++;  // Wraps at 0xFF, same as the hardware
+		}
+		return length;
+	}
+}
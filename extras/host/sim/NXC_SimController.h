@@ -0,0 +1,70 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_SimController_h
+#define NXC_SimController_h
+
+#include <Wire.h>
+#include "internal/NXC_Identity.h"
+
+namespace NXC_Host {
+	// Simulated extension controller, as seen at 0x52 on the simulated bus.
+	// Writes set the register pointer (or a register, for initialization) and
+	// reads return the register space from the pointer onwards, same as the
+	// real thing. Until initialized, reads return 0xFF.
+	class SimulatedController : public I2CDevice {
+	public:
+		static const uint8_t Address = 0x52;
+
+		static const uint8_t ControlDataStart = 0x00;
+		static const uint8_t IdentityStart = 0xFA;
+
+		SimulatedController(ExtensionType type = ExtensionType::ClassicController);
+
+		void setType(ExtensionType type);  // Sets ID and neutral control data
+		void setID(const uint8_t * id);
+		void setControlData(uint8_t index, uint8_t value);
+		void setControlData(const uint8_t * data, size_t size);
+
+		const uint8_t * registerData() const { return registers; }
+		bool initialized() const { return init; }
+		void reset();  // Back to uninitialized
+
+		bool receive(const uint8_t * data, size_t length) override;
+		size_t transmit(uint8_t * data, size_t length) override;
+
+		uint32_t writeCount() const { return writes; }
+		uint32_t readCount() const { return reads; }
+
+	protected:
+		uint8_t registers[256];
+		uint8_t pointer = 0;
+
+		bool init = false;
+		bool initStep1 = false;  // 0x55 written to 0xF0
+
+		uint32_t writes = 0;
+		uint32_t reads = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,181 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_TimedBus.h"
+
+namespace NXC_Host {
+	TimedBus::TimedBus(I2CBus & target, uint32_t clockHz) : bus(target) {
+		setClock(clockHz);
+		resetStats();
+	}
+
+	void TimedBus::setClock(uint32_t hz) {
+		clock = hz > 0 ? hz : 100000;
+		bus.setClock(hz);
+	}
+
+	double TimedBus::transferTime(size_t bytes) const {
+		const double bitUs = 1000000.0 / clock;
+		const double bits = 9.0 * (bytes + 1) + 2.0;  // Address + data, 9 bits each, plus start/stop
+		return bits * bitUs + stretchUs * (bytes + 1);
+	}
+
+	bool TimedBus::injectFault(FaultType type, uint8_t bytes, uint16_t skip) {
+		if (faultCount >= MaxFaults) return false;
+		script[faultCount++] = { type, bytes, skip };
+		return true;
+	}
+
+	bool TimedBus::takeFault(bool isRead, Fault & out) {
+		if (faultCount == 0) return false;
+
+		Fault & f = script[0];
+		const bool readOnly = f.type == FaultType::ZeroFrame || f.type == FaultType::MaxFrame || f.type == FaultType::DropBytes;
+		const bool writeOnly = f.type == FaultType::DataNACK;
+
+		if ((readOnly && !isRead) || (writeOnly && isRead)) {
+			return false;  // Not eligible, wait for the right transaction
+		}
+
+		if (f.skip > 0) {
+			f.skip--;
+			return false;
+		}
+
+		out = f;
+		for (uint8_t i = 1; i < faultCount; i++) {
+			script[i - 1] = script[i];
+		}
+		faultCount--;
+		faults++;
+		return true;
+	}
+
+	double TimedBus::now() const {
+		return (double) simulatedTime() + fraction;
+	}
+
+	void TimedBus::charge(Phase p, double us) {
+		PhaseStats & s = phaseStats[(uint8_t) p];
+		s.count++;
+		s.totalUs += us;
+		if (us > s.maxUs) s.maxUs = us;
+
+		if (p == Phase::ConversionWait) return;  // Already spent by the caller's delay
+
+		// Add whole microseconds to the simulated clock, carrying the rest
+		fraction += us;
+		const uint64_t whole = (uint64_t) fraction;
+		fraction -= whole;
+		advanceTime(whole);
+	}
+
+	uint8_t TimedBus::write(uint8_t addr, const uint8_t * data, size_t length) {
+		Fault f;
+		if (takeFault(false, f)) {
+			if (f.type == FaultType::AddrNACK) {
+				charge(length > 1 ? Phase::RegisterWrite : Phase::PointerWrite, transferTime(0));
+				pointerDoneAt = -1.0;
+				return I2C_AddrNACK;
+			}
+			else if (f.type == FaultType::DataNACK) {
+				charge(length > 1 ? Phase::RegisterWrite : Phase::PointerWrite, transferTime(1));
+				pointerDoneAt = -1.0;
+				return I2C_DataNACK;
+			}
+		}
+
+		const uint8_t status = bus.write(addr, data, length);
+		charge(length > 1 ? Phase::RegisterWrite : Phase::PointerWrite,
+			transferTime(status == I2C_AddrNACK ? 0 : length));
+
+		pointerDoneAt = (status == I2C_OK && length == 1) ? now() : -1.0;
+		return status;
+	}
+
+	size_t TimedBus::read(uint8_t addr, uint8_t * data, size_t length) {
+		if (pointerDoneAt >= 0.0) {
+			charge(Phase::ConversionWait, now() - pointerDoneAt);
+		}
+
+		const bool ready = pointerDoneAt >= 0.0 && now() - pointerDoneAt >= conversionUs;
+		pointerDoneAt = -1.0;
+
+		Fault f;
+		const bool fault = takeFault(true, f);
+
+		if (fault && f.type == FaultType::AddrNACK) {
+			charge(Phase::Read, transferTime(0));
+			return 0;
+		}
+
+		size_t n = bus.read(addr, data, length);
+
+		if (n > 0 && !ready && conversionUs > 0) {
+			memset(data, 0xFF, n);  // Read too soon, the controller isn't ready
+			early++;
+		}
+
+		if (fault) {
+			switch (f.type) {
+				case FaultType::ZeroFrame:
+					memset(data, 0x00, n);
+					break;
+				case FaultType::MaxFrame:
+					memset(data, 0xFF, n);
+					break;
+				case FaultType::DropBytes:
+					n = f.bytes < n ? n - f.bytes : 0;
+					break;
+				default:
+					break;
+			}
+		}
+
+		charge(Phase::Read, transferTime(n));
+		return n;
+	}
+
+	void TimedBus::resetStats() {
+		memset(phaseStats, 0, sizeof(phaseStats));
+		faults = 0;
+		early = 0;
+	}
+
+	const char * TimedBus::phaseName(Phase p) {
+		switch (p) {
+			case Phase::PointerWrite: return "pointer_write";
+			case Phase::RegisterWrite: return "register_write";
+			case Phase::ConversionWait: return "conversion_wait";
+			case Phase::Read: return "read";
+			default: return "unknown";
+		}
+	}
+
+	void TimedBus::report(FILE * out) const {
+		for (uint8_t i = 0; i < (uint8_t) Phase::NumPhases; i++) {
+			const PhaseStats & s = phaseStats[i];
+			fprintf(out, "{\"phase\":\"%s\",\"clock_hz\":%u,\"count\":%u,\"total_us\":%.3f,\"mean_us\":%.3f,\"max_us\":%.3f}\n",
+				phaseName((Phase) i), clock, s.count, s.totalUs, s.count ? s.totalUs / s.count : 0.0, s.maxUs);
+		}
+	}
+}
@@ -0,0 +1,115 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_TimedBus_h
+#define NXC_TimedBus_h
+
+#include <Wire.h>
+
+namespace NXC_Host {
+	// Wraps another bus backend and charges simulated time for each transaction
+	// based on the bus clock: 9 bit times per byte (8 data + ACK) plus start and
+	// stop, with optional clock stretching per byte. It also models the
+	// controller's conversion time after a pointer write, and can inject faults
+	// from a script. Time is tracked per phase for the latency breakdown.
+	class TimedBus : public I2CBus {
+	public:
+		enum class Phase : uint8_t {
+			PointerWrite,    // Single byte writes, setting the read pointer
+			RegisterWrite,   // Multi-byte writes (initialization)
+			ConversionWait,  // From the end of a pointer write to the next read
+			Read,
+			NumPhases,
+		};
+
+		enum class FaultType : uint8_t {
+			AddrNACK,   // No ACK for the address, on the next transaction
+			DataNACK,   // No ACK for the data, on the next write
+			ZeroFrame,  // Next read returns all 0x00
+			MaxFrame,   // Next read returns all 0xFF
+			DropBytes,  // Next read comes up 'bytes' short
+		};
+
+		struct PhaseStats {
+			uint32_t count;
+			double totalUs;
+			double maxUs;
+		};
+
+		TimedBus(I2CBus & target, uint32_t clockHz = 100000);
+
+		void begin() override { bus.begin(); }
+		void setClock(uint32_t hz) override;
+		uint32_t getClock() const { return clock; }
+
+		void setStretch(double usPerByte) { stretchUs = usPerByte; }  // Clock stretching per byte
+		void setConversionTime(uint32_t us) { conversionUs = us; }    // Time before data is ready
+
+		// Queue a fault to fire after 'skip' more eligible transactions
+		bool injectFault(FaultType type, uint8_t bytes = 0, uint16_t skip = 0);
+		void clearFaults() { faultCount = 0; }
+		uint8_t pendingFaults() const { return faultCount; }
+
+		uint8_t write(uint8_t addr, const uint8_t * data, size_t length) override;
+		size_t read(uint8_t addr, uint8_t * data, size_t length) override;
+
+		double transferTime(size_t bytes) const;  // Address + 'bytes', start to stop, in us
+
+		const PhaseStats & stats(Phase p) const { return phaseStats[(uint8_t) p]; }
+		uint32_t faultsFired() const { return faults; }
+		uint32_t earlyReads() const { return early; }
+		void resetStats();
+
+		void report(FILE * out) const;  // One JSON line per phase
+
+		static const char * phaseName(Phase p);
+
+	private:
+		struct Fault {
+			FaultType type;
+			uint8_t bytes;
+			uint16_t skip;
+		};
+
+		bool takeFault(bool isRead, Fault & out);
+		void charge(Phase p, double us);
+		double now() const;  // Simulated time, in us
+
+		I2CBus & bus;
+		uint32_t clock;
+		double stretchUs = 0.0;
+		uint32_t conversionUs = 0;
+
+		static const uint8_t MaxFaults = 16;
+		Fault script[MaxFaults];
+		uint8_t faultCount = 0;
+
+		double fraction = 0.0;  // Sub-microsecond time not yet added to the clock
+		double pointerDoneAt = -1.0;  // End of the last pointer write, or -1
+
+		PhaseStats phaseStats[(uint8_t) Phase::NumPhases];
+		uint32_t faults = 0;
+		uint32_t early = 0;
+	};
+}
+
+#endif
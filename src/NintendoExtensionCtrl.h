@@ -36,4 +36,14 @@
 // Mini Controllers
 /* (included with ClassicController.h) */
 
+// Utilities
+#include "utility/NXC_Remap.h"
+#include "utility/NXC_Telemetry.h"
+#include "utility/NXC_DebugQueue.h"
+#include "utility/NXC_Capture.h"
+#include "utility/NXC_HIDReport.h"
+#include "utility/NXC_Scheduler.h"
+#include "utility/NXC_MultiController.h"
+#include "utility/NXC_SplitUpdate.h"
+
 #endif
@@ -20,6 +20,7 @@
 *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#define NXC_ClassicController_cpp  // Out-of-line accessors are built here
 #include "ClassicController.h"
 
 namespace NintendoExtensionCtrl {
@@ -52,103 +53,9 @@ constexpr BitMap  ClassicController_Shared::Maps::ButtonPlus;
 constexpr BitMap  ClassicController_Shared::Maps::ButtonMinus;
 constexpr BitMap  ClassicController_Shared::Maps::ButtonHome;
 
-uint8_t ClassicController_Shared::leftJoyX() const {
-	return getControlData(Maps::LeftJoyX);
-}
-
-uint8_t ClassicController_Shared::leftJoyY() const {
-	return getControlData(Maps::LeftJoyY);
-}
-
-uint8_t ClassicController_Shared::rightJoyX() const {
-	return getControlData(Maps::RightJoyX);
-}
-
-uint8_t ClassicController_Shared::rightJoyY() const {
-	return getControlData(Maps::RightJoyY);
-}
-
-boolean ClassicController_Shared::dpadUp() const {
-	return getControlBit(Maps::DpadUp);
-}
-
-boolean ClassicController_Shared::dpadDown() const {
-	return getControlBit(Maps::DpadDown);
-}
-
-boolean ClassicController_Shared::dpadLeft() const {
-	return getControlBit(Maps::DpadLeft);
-}
-
-boolean ClassicController_Shared::dpadRight() const {
-	return getControlBit(Maps::DpadRight);
-}
-
-boolean ClassicController_Shared::buttonA() const {
-	return getControlBit(Maps::ButtonA);
-}
-
-boolean ClassicController_Shared::buttonB() const {
-	return getControlBit(Maps::ButtonB);
-}
-
-boolean ClassicController_Shared::buttonX() const {
-	return getControlBit(Maps::ButtonX);
-}
-
-boolean ClassicController_Shared::buttonY() const {
-	return getControlBit(Maps::ButtonY);
-}
-
-uint8_t ClassicController_Shared::triggerL() const {
-	return getControlData(Maps::TriggerL);
-}
-
-uint8_t ClassicController_Shared::triggerR() const {
-	return getControlData(Maps::TriggerR);
-}
-
-boolean ClassicController_Shared::buttonL() const {
-	return getControlBit(Maps::ButtonL);
-}
-
-boolean ClassicController_Shared::buttonR() const {
-	return getControlBit(Maps::ButtonR);
-}
-
-boolean ClassicController_Shared::buttonZL() const {
-	return getControlBit(Maps::ButtonZL);
-}
-
-boolean ClassicController_Shared::buttonZR() const {
-	return getControlBit(Maps::ButtonZR);
-}
-
-boolean ClassicController_Shared::buttonStart() const {
-	return buttonPlus();
-}
-
-boolean ClassicController_Shared::buttonSelect() const {
-	return buttonMinus();
-}
-
-boolean ClassicController_Shared::buttonPlus() const {
-	return getControlBit(Maps::ButtonPlus);
-}
-
-boolean ClassicController_Shared::buttonMinus() const {
-	return getControlBit(Maps::ButtonMinus);
-}
-
-boolean ClassicController_Shared::buttonHome() const {
-	return getControlBit(Maps::ButtonHome);
-}
-
 void ClassicController_Shared::printDebug(Print& output) const {
 	const char fillCharacter = '_';
 
-	char buffer[62];
-
 	char dpadLPrint = dpadLeft() ? '<' : fillCharacter;
 	char dpadUPrint = dpadUp() ? '^' : fillCharacter;
 	char dpadDPrint = dpadDown() ? 'v' : fillCharacter;
@@ -170,15 +77,38 @@ void ClassicController_Shared::printDebug(Print& output) const {
 	char zrButtonPrint = buttonZR() ? 'R' : fillCharacter;
 
 	output.print("Classic ");
-	sprintf(buffer,
-		"%c%c%c%c | %c%c%c | %c%c%c%c L:(%2u, %2u) R:(%2u, %2u) | LT:%2u%c RT:%2u%c Z:%c%c",
-		dpadLPrint, dpadUPrint, dpadDPrint, dpadRPrint,
-		minusPrint, homePrint, plusPrint,
-		aButtonPrint, bButtonPrint, xButtonPrint, yButtonPrint,
-		leftJoyX(), leftJoyY(), rightJoyX(), rightJoyY(),
-		triggerL(), ltButtonPrint, triggerR(), rtButtonPrint,
-		zlButtonPrint, zrButtonPrint);
-	output.println(buffer);
+	output.print(dpadLPrint);
+	output.print(dpadUPrint);
+	output.print(dpadDPrint);
+	output.print(dpadRPrint);
+	output.print(" | ");
+	output.print(minusPrint);
+	output.print(homePrint);
+	output.print(plusPrint);
+	output.print(" | ");
+	output.print(aButtonPrint);
+	output.print(bButtonPrint);
+	output.print(xButtonPrint);
+	output.print(yButtonPrint);
+
+	output.print(" L:(");
+	printPadded(leftJoyX(), 2, output);
+	output.print(", ");
+	printPadded(leftJoyY(), 2, output);
+	output.print(") R:(");
+	printPadded(rightJoyX(), 2, output);
+	output.print(", ");
+	printPadded(rightJoyY(), 2, output);
+
+	output.print(") | LT:");
+	printPadded(triggerL(), 2, output);
+	output.print(ltButtonPrint);
+	output.print(" RT:");
+	printPadded(triggerR(), 2, output);
+	output.print(rtButtonPrint);
+	output.print(" Z:");
+	output.print(zlButtonPrint);
+	output.println(zrButtonPrint);
 }
 
 // ######### Mini Controller Support #########
@@ -186,14 +116,46 @@ void ClassicController_Shared::printDebug(Print& output) const {
 boolean ClassicController_Shared::fixNESKnockoffData() {
 	// Public-facing function to check and "correct" data if using a knockoff
 	// Returns 'true' if data was modified
-	if(isNESKnockoff()) { 
-		manipulateKnockoffData();
-		return true;
+	//
+	// The fixup runs inside update() from now on, on each raw frame before
+	// the button debounce, axis filter and events see it.
+	attachFixup(&fixKnockoffFrame);
+
+#if !NXC_ENABLE_ISR_SAFE
+	// The frame read before it was attached is fixed in place. With
+	// interrupt-safe ports update() may be swapping the buffers, so that
+	// one frame is left as it is.
+	if (!frameFixed()) {
+		uint8_t frame[8];
+		for (uint8_t i = 0; i < sizeof(frame); i++) {
+			frame[i] = getControlData(i);
+		}
+
+		NXC_TRACE_BEGIN(getExtensionData(), KnockoffFixup);
+		const boolean knockoff = fixKnockoffFrame(frame);
+		if (knockoff) {
+			for (uint8_t i = 0; i < 6; i++) {  // Bytes 6 and 7 are unchanged
+				setControlData(i, frame[i]);
+			}
+		}
+		NXC_TRACE_END(getExtensionData(), KnockoffFixup);
+
+		return knockoff;
 	}
-	return false;
+#endif
+
+	return frameFixed();
 }
 
 boolean ClassicController_Shared::isNESKnockoff() const {
+	uint8_t frame[6];
+	for (uint8_t i = 0; i < sizeof(frame); i++) {
+		frame[i] = getControlData(i);
+	}
+	return isKnockoffFrame(frame);
+}
+
+boolean ClassicController_Shared::isKnockoffFrame(const uint8_t * frame) {
 	// The NES knockoffs I've come across seem to display the same unchanging pattern
 	// for the first six control bytes:
 	//
@@ -212,15 +174,19 @@ boolean ClassicController_Shared::isNESKnockoff() const {
 	// Because of that, we can reasonably assume that if the bytes match this then the
 	// connected controller is an NES Knockoff, and can be treated accordingly. 
 
-	return getControlData(0) == 0x81 &&  // RX 4:3, LX
-	       getControlData(1) == 0x81 &&  // RX 2:1, LY
-	       getControlData(2) == 0x81 &&  // RX 0, LT 4:3, RY
-	       getControlData(3) == 0x81 &&  // LT 2:0, RT
-	       getControlData(4) == 0x00 &&  // Button packet 1 (all pressed)
-	       getControlData(5) == 0x00;    // Button packet 2 (all pressed)
+	return frame[0] == 0x81 &&  // RX 4:3, LX
+	       frame[1] == 0x81 &&  // RX 2:1, LY
+	       frame[2] == 0x81 &&  // RX 0, LT 4:3, RY
+	       frame[3] == 0x81 &&  // LT 2:0, RT
+	       frame[4] == 0x00 &&  // Button packet 1 (all pressed)
+	       frame[5] == 0x00;    // Button packet 2 (all pressed)
 }
 
-void ClassicController_Shared::manipulateKnockoffData() {
+boolean ClassicController_Shared::fixKnockoffFrame(uint8_t * frame) {
+	if (!isKnockoffFrame(frame)) {
+		return false;
+	}
+
 	// The data returned by knockoff NES controllers for the missing control surfaces
 	// (joysticks, triggers, etc.) is "corrupted", meaning that it doesn't align with
 	// what you would expect a Classic Controller at rest to display.
@@ -241,12 +207,13 @@ void ClassicController_Shared::manipulateKnockoffData() {
 	// matter. Bytes 0, 1, 2, and 3 (joysticks and triggers) are replaced entirely. Bytes
 	// 4 and 5 are overridden by the values in 6 and 7.
 
-	setControlData(0, 0x5F);
-	setControlData(1, 0xDF);
-	setControlData(2, 0x8F);
-	setControlData(3, 0x00);
-	setControlData(4, getControlData(6));
-	setControlData(5, getControlData(7));
+	frame[0] = 0x5F;
+	frame[1] = 0xDF;
+	frame[2] = 0x8F;
+	frame[3] = 0x00;
+	frame[4] = frame[6];
+	frame[5] = frame[7];
+	return true;
 }
 
 void NESMiniController_Shared::printDebug(Print& output) const {
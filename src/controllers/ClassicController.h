@@ -105,7 +105,8 @@ namespace NintendoExtensionCtrl {
 		boolean fixNESKnockoffData();
 
 	protected:
-		void manipulateKnockoffData();
+		static boolean isKnockoffFrame(const uint8_t * frame);
+		static boolean fixKnockoffFrame(uint8_t * frame);  // 'true' if it was a knockoff's
 	};
 
 	class NESMiniController_Shared : public ClassicController_Shared {
@@ -126,6 +127,103 @@ namespace NintendoExtensionCtrl {
 	};
 }
 
+// Accessors, inlined with NXC_INLINE_ACCESSORS or built once in ClassicController.cpp
+#if NXC_INLINE_ACCESSORS || defined(NXC_ClassicController_cpp)
+namespace NintendoExtensionCtrl {
+	NXC_ACCESSOR uint8_t ClassicController_Shared::leftJoyX() const {
+		return getControlData(Maps::LeftJoyX);
+	}
+
+	NXC_ACCESSOR uint8_t ClassicController_Shared::leftJoyY() const {
+		return getControlData(Maps::LeftJoyY);
+	}
+
+	NXC_ACCESSOR uint8_t ClassicController_Shared::rightJoyX() const {
+		return getControlData(Maps::RightJoyX);
+	}
+
+	NXC_ACCESSOR uint8_t ClassicController_Shared::rightJoyY() const {
+		return getControlData(Maps::RightJoyY);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::dpadUp() const {
+		return getControlBit(Maps::DpadUp);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::dpadDown() const {
+		return getControlBit(Maps::DpadDown);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::dpadLeft() const {
+		return getControlBit(Maps::DpadLeft);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::dpadRight() const {
+		return getControlBit(Maps::DpadRight);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonA() const {
+		return getControlBit(Maps::ButtonA);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonB() const {
+		return getControlBit(Maps::ButtonB);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonX() const {
+		return getControlBit(Maps::ButtonX);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonY() const {
+		return getControlBit(Maps::ButtonY);
+	}
+
+	NXC_ACCESSOR uint8_t ClassicController_Shared::triggerL() const {
+		return getControlData(Maps::TriggerL);
+	}
+
+	NXC_ACCESSOR uint8_t ClassicController_Shared::triggerR() const {
+		return getControlData(Maps::TriggerR);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonL() const {
+		return getControlBit(Maps::ButtonL);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonR() const {
+		return getControlBit(Maps::ButtonR);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonZL() const {
+		return getControlBit(Maps::ButtonZL);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonZR() const {
+		return getControlBit(Maps::ButtonZR);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonStart() const {
+		return buttonPlus();
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonSelect() const {
+		return buttonMinus();
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonPlus() const {
+		return getControlBit(Maps::ButtonPlus);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonMinus() const {
+		return getControlBit(Maps::ButtonMinus);
+	}
+
+	NXC_ACCESSOR boolean ClassicController_Shared::buttonHome() const {
+		return getControlBit(Maps::ButtonHome);
+	}
+}
+#endif
+
 using ClassicController = NintendoExtensionCtrl::BuildControllerClass
 	<NintendoExtensionCtrl::ClassicController_Shared>;
 
@@ -20,6 +20,7 @@
 *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#define NXC_DJTurntable_cpp  // Out-of-line accessors are built here
 #include "DJTurntable.h"
 
 namespace NintendoExtensionCtrl {
@@ -65,34 +66,6 @@ boolean DJTurntableController_Shared::buttonBlue() const {
 }
 
 // Main Board
-uint8_t DJTurntableController_Shared::effectDial() const {
-	return getControlData(Maps::EffectDial);
-}
-
-int8_t DJTurntableController_Shared::crossfadeSlider() const {
-	return getControlData(Maps::CrossfadeSlider) - 8;  // Shifted to signed int
-}
-
-boolean DJTurntableController_Shared::buttonEuphoria() const {
-	return getControlBit(Maps::ButtonEuphoria);
-}
-
-uint8_t DJTurntableController_Shared::joyX() const {
-	return getControlData(Maps::JoyX);
-}
-
-uint8_t DJTurntableController_Shared::joyY() const {
-	return getControlData(Maps::JoyY);
-}
-
-boolean DJTurntableController_Shared::buttonPlus() const {
-	return getControlBit(Maps::ButtonPlus);
-}
-
-boolean DJTurntableController_Shared::buttonMinus() const {
-	return getControlBit(Maps::ButtonMinus);
-}
-
 DJTurntableController_Shared::TurntableConfig DJTurntableController_Shared::getTurntableConfig() {
 	if (tableConfig == TurntableConfig::Both) {
 		return tableConfig;  // Both are attached, no reason to check data
@@ -136,8 +109,6 @@ uint8_t DJTurntableController_Shared::getNumTurntables() {
 void DJTurntableController_Shared::printDebug(Print& output) {
 	const char fillCharacter = '_';
 
-	char buffer[45];
-
 	output.print("DJ:");
 
 	if (getNumTurntables() == 0) {
@@ -153,13 +124,19 @@ void DJTurntableController_Shared::printDebug(Print& output) {
 
 	char euphoriaPrint = buttonEuphoria() ? 'E' : fillCharacter;
 
-	sprintf(buffer,
-		" Joy:(%2u, %2u) | %c | %c%c | FX: %2u | Fade: %2d",
-		joyX(), joyY(),
-		euphoriaPrint,
-		minusPrint, plusPrint,
-		effectDial(), crossfadeSlider());
-	output.print(buffer);
+	output.print(" Joy:(");
+	printPadded(joyX(), 2, output);
+	output.print(", ");
+	printPadded(joyY(), 2, output);
+	output.print(") | ");
+	output.print(euphoriaPrint);
+	output.print(" | ");
+	output.print(minusPrint);
+	output.print(plusPrint);
+	output.print(" | FX: ");
+	printPadded(effectDial(), 2, output);
+	output.print(" | Fade: ");
+	printPadded(crossfadeSlider(), 2, output);
 
 	if (right.connected()) {
 		output.print(" |");
@@ -183,13 +160,14 @@ void DJTurntableController_Shared::printTurntable(Print& output, TurntableExpans
 	char redPrint = table.buttonRed() ? 'R' : fillCharacter;
 	char bluePrint = table.buttonBlue() ? 'B' : fillCharacter;
 
-	char buffer[15];
-	sprintf(buffer,
-		" T%c:%3d %c%c%c",
-		idPrint,
-		table.turntable(),
-		greenPrint, redPrint, bluePrint);
-	output.print(buffer);
+	output.print(" T");
+	output.print(idPrint);
+	output.print(':');
+	printPadded(table.turntable(), 3, output);
+	output.print(' ');
+	output.print(greenPrint);
+	output.print(redPrint);
+	output.print(bluePrint);
 }
 
 // Turntable Expansion Base
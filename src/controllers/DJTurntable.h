@@ -151,6 +151,39 @@ namespace NintendoExtensionCtrl {
 	};
 }
 
+// Accessors, inlined with NXC_INLINE_ACCESSORS or built once in DJTurntable.cpp
+#if NXC_INLINE_ACCESSORS || defined(NXC_DJTurntable_cpp)
+namespace NintendoExtensionCtrl {
+	NXC_ACCESSOR uint8_t DJTurntableController_Shared::effectDial() const {
+		return getControlData(Maps::EffectDial);
+	}
+
+	NXC_ACCESSOR int8_t DJTurntableController_Shared::crossfadeSlider() const {
+		return getControlData(Maps::CrossfadeSlider) - 8;  // Shifted to signed int
+	}
+
+	NXC_ACCESSOR boolean DJTurntableController_Shared::buttonEuphoria() const {
+		return getControlBit(Maps::ButtonEuphoria);
+	}
+
+	NXC_ACCESSOR uint8_t DJTurntableController_Shared::joyX() const {
+		return getControlData(Maps::JoyX);
+	}
+
+	NXC_ACCESSOR uint8_t DJTurntableController_Shared::joyY() const {
+		return getControlData(Maps::JoyY);
+	}
+
+	NXC_ACCESSOR boolean DJTurntableController_Shared::buttonPlus() const {
+		return getControlBit(Maps::ButtonPlus);
+	}
+
+	NXC_ACCESSOR boolean DJTurntableController_Shared::buttonMinus() const {
+		return getControlBit(Maps::ButtonMinus);
+	}
+}
+#endif
+
 using DJTurntableController = NintendoExtensionCtrl::BuildControllerClass
 	<NintendoExtensionCtrl::DJTurntableController_Shared>;
 
@@ -20,6 +20,7 @@
 *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#define NXC_DrumController_cpp  // Out-of-line accessors are built here
 #include "DrumController.h"
 
 namespace NintendoExtensionCtrl {
@@ -43,50 +44,6 @@ constexpr ByteMap DrumController_Shared::Maps::Velocity;
 constexpr ByteMap DrumController_Shared::Maps::VelocityID;
 constexpr BitMap  DrumController_Shared::Maps::VelocityAvailable;
 
-uint8_t DrumController_Shared::joyX() const {
-	return getControlData(Maps::JoyX);
-}
-
-uint8_t DrumController_Shared::joyY() const {
-	return getControlData(Maps::JoyY);
-}
-
-boolean DrumController_Shared::drumRed() const {
-	return getControlBit(Maps::DrumRed);
-}
-
-boolean DrumController_Shared::drumBlue() const {
-	return getControlBit(Maps::DrumBlue);
-}
-
-boolean DrumController_Shared::drumGreen() const {
-	return getControlBit(Maps::DrumGreen);
-}
-
-boolean DrumController_Shared::cymbalYellow() const {
-	return getControlBit(Maps::CymbalYellow);
-}
-
-boolean DrumController_Shared::cymbalOrange() const {
-	return getControlBit(Maps::CymbalOrange);
-}
-
-boolean DrumController_Shared::bassPedal() const {
-	return getControlBit(Maps::Pedal);
-}
-
-boolean DrumController_Shared::buttonPlus() const {
-	return getControlBit(Maps::ButtonPlus);
-}
-
-boolean DrumController_Shared::buttonMinus() const {
-	return getControlBit(Maps::ButtonMinus);
-}
-
-boolean DrumController_Shared::velocityAvailable() const {
-	return getControlBit(Maps::VelocityAvailable);
-}
-
 DrumController_Shared::VelocityID DrumController_Shared::velocityID() const {
 	uint8_t id = getControlData(Maps::VelocityID);  // 5 bit identifier
 
@@ -155,9 +112,7 @@ uint8_t DrumController_Shared::velocityPedal() const {
 
 void DrumController_Shared::printDebug(Print& output) const {
 	const char fillCharacter = '_';
-	
-	char buffer[45];
-	
+
 	output.print("Drums: ");
 
 	char redPrint = drumRed() ? 'R' : fillCharacter;
@@ -202,13 +157,30 @@ void DrumController_Shared::printDebug(Print& output) const {
 	char plusPrint = buttonPlus() ? '+' : fillCharacter;
 	char minusPrint = buttonMinus() ? '-' : fillCharacter;
 
-	sprintf(buffer,
-		"%c\\%c%c%c/%c %c | V:%1u for %c | %c%c | Joy:(%2u, %2u)",
-		yellowPrint, redPrint, bluePrint, greenPrint, orangePrint, pedalPrint,
-		velocityPrint, velocityIDPrint,
-		minusPrint, plusPrint,
-		joyX(), joyY());
-	output.println(buffer);
+	output.print(yellowPrint);
+	output.print('\\');
+	output.print(redPrint);
+	output.print(bluePrint);
+	output.print(greenPrint);
+	output.print('/');
+	output.print(orangePrint);
+	output.print(' ');
+	output.print(pedalPrint);
+
+	output.print(" | V:");
+	printPadded(velocityPrint, 1, output);
+	output.print(" for ");
+	output.print(velocityIDPrint);
+
+	output.print(" | ");
+	output.print(minusPrint);
+	output.print(plusPrint);
+
+	output.print(" | Joy:(");
+	printPadded(joyX(), 2, output);
+	output.print(", ");
+	printPadded(joyY(), 2, output);
+	output.println(')');
 }
 
 }  // End "NintendoExtensionCtrl" namespace
@@ -102,6 +102,55 @@ namespace NintendoExtensionCtrl {
 	};
 }
 
+// Accessors, inlined with NXC_INLINE_ACCESSORS or built once in DrumController.cpp
+#if NXC_INLINE_ACCESSORS || defined(NXC_DrumController_cpp)
+namespace NintendoExtensionCtrl {
+	NXC_ACCESSOR uint8_t DrumController_Shared::joyX() const {
+		return getControlData(Maps::JoyX);
+	}
+
+	NXC_ACCESSOR uint8_t DrumController_Shared::joyY() const {
+		return getControlData(Maps::JoyY);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::drumRed() const {
+		return getControlBit(Maps::DrumRed);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::drumBlue() const {
+		return getControlBit(Maps::DrumBlue);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::drumGreen() const {
+		return getControlBit(Maps::DrumGreen);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::cymbalYellow() const {
+		return getControlBit(Maps::CymbalYellow);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::cymbalOrange() const {
+		return getControlBit(Maps::CymbalOrange);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::bassPedal() const {
+		return getControlBit(Maps::Pedal);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::buttonPlus() const {
+		return getControlBit(Maps::ButtonPlus);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::buttonMinus() const {
+		return getControlBit(Maps::ButtonMinus);
+	}
+
+	NXC_ACCESSOR boolean DrumController_Shared::velocityAvailable() const {
+		return getControlBit(Maps::VelocityAvailable);
+	}
+}
+#endif
+
 using DrumController = NintendoExtensionCtrl::BuildControllerClass
 	<NintendoExtensionCtrl::DrumController_Shared>;
 
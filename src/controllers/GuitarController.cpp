@@ -20,6 +20,7 @@
 *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#define NXC_GuitarController_cpp  // Out-of-line accessors are built here
 #include "GuitarController.h"
 
 namespace NintendoExtensionCtrl {
@@ -42,81 +43,46 @@ constexpr BitMap  GuitarController_Shared::Maps::FretOrange;
 constexpr ByteMap GuitarController_Shared::Maps::Whammy;
 constexpr ByteMap GuitarController_Shared::Maps::Touchbar;
 
-uint8_t GuitarController_Shared::joyX() const {
-	return getControlData(Maps::JoyX);
-}
-
-uint8_t GuitarController_Shared::joyY() const {
-	return getControlData(Maps::JoyY);
-}
-
-boolean GuitarController_Shared::strum() const {
-	return strumUp() | strumDown();
-}
-
-boolean GuitarController_Shared::strumUp() const {
-	return getControlBit(Maps::StrumUp);
-}
-
-boolean GuitarController_Shared::strumDown() const {
-	return getControlBit(Maps::StrumDown);
-}
-
-boolean GuitarController_Shared::fretGreen() const {
-	return getControlBit(Maps::FretGreen);
-}
-
-boolean GuitarController_Shared::fretRed() const {
-	return getControlBit(Maps::FretRed);
-}
-
-boolean GuitarController_Shared::fretYellow() const {
-	return getControlBit(Maps::FretYellow);
-}
-
-boolean GuitarController_Shared::fretBlue() const {
-	return getControlBit(Maps::FretBlue);
-}
-
-boolean GuitarController_Shared::fretOrange() const {
-	return getControlBit(Maps::FretOrange);
-}
-
-uint8_t GuitarController_Shared::whammyBar() const {
-	return getControlData(Maps::Whammy);
-}
-
-uint8_t GuitarController_Shared::touchbar() const {
-	return getControlData(Maps::Touchbar);
-}
+// Touchbar values overlap between regions, so each value maps to one or two
+// frets. 15 is the "not touched" value, and 31 is reported by guitars without
+// a touchbar (kept as orange to match the original range checks).
+const uint8_t GuitarController_Shared::TouchRegions[32] = {
+	0,                                           // 0
+	Green, Green, Green, Green, Green, Green,     // 1 - 6
+	Green | Red,                                 // 7
+	Red, Red, Red, Red,                          // 8 - 11
+	Red | Yellow, Red | Yellow,                  // 12 - 13
+	Yellow,                                      // 14
+	0,                                           // 15, not touched
+	Yellow, Yellow, Yellow, Yellow,              // 16 - 19
+	Yellow | Blue, Yellow | Blue,                // 20 - 21
+	Blue, Blue, Blue, Blue,                      // 22 - 25
+	Blue | Orange,                               // 26
+	Orange, Orange, Orange, Orange, Orange,      // 27 - 31
+};
 
 boolean GuitarController_Shared::touchGreen() const {
-	return touchbar() != 0 && touchbar() <= 7;
+	return touchMask() & Fret::Green;
 }
 
 boolean GuitarController_Shared::touchRed() const {
-	return touchbar() >= 7 && touchbar() <= 13;
+	return touchMask() & Fret::Red;
 }
 
 boolean GuitarController_Shared::touchYellow() const {
-	return touchbar() >= 12 && touchbar() <= 21
-		&& touchbar() != 15;	// The "not touched" value
+	return touchMask() & Fret::Yellow;
 }
 
 boolean GuitarController_Shared::touchBlue() const {
-	return touchbar() >= 20 && touchbar() <= 26;
+	return touchMask() & Fret::Blue;
 }
 
 boolean GuitarController_Shared::touchOrange() const {
-	return touchbar() >= 26;
-}
-
-boolean GuitarController_Shared::buttonPlus() const {
-	return getControlBit(Maps::ButtonPlus);
+	return touchMask() & Fret::Orange;
 }
 
-boolean GuitarController_Shared::buttonMinus() const {
-	return getControlBit(Maps::ButtonMinus);
+uint8_t GuitarController_Shared::touchMask() const {
+	return TouchRegions[touchbar()];
 }
 
 boolean GuitarController_Shared::supportsTouchbar() {
@@ -132,8 +98,6 @@ boolean GuitarController_Shared::supportsTouchbar() {
 void GuitarController_Shared::printDebug(Print& output) {
 	const char fillCharacter = '_';
 
-	char buffer[25];
-
 	output.print("Guitar: ");
 
 	// Strum + Fret Buttons
@@ -151,13 +115,16 @@ void GuitarController_Shared::printDebug(Print& output) {
 	char bluePrint = fretBlue() ? 'B' : fillCharacter;
 	char orangePrint = fretOrange() ? 'O' : fillCharacter;
 
-	sprintf(buffer,
-		"%c | %c%c%c%c%c | W:%2u ",
-		strumPrint,
-		greenPrint, redPrint, yellowPrint, bluePrint, orangePrint,
-		whammyBar());
-	output.print(buffer);
-	buffer[0] = 0;
+	output.print(strumPrint);
+	output.print(" | ");
+	output.print(greenPrint);
+	output.print(redPrint);
+	output.print(yellowPrint);
+	output.print(bluePrint);
+	output.print(orangePrint);
+	output.print(" | W:");
+	printPadded(whammyBar(), 2, output);
+	output.print(' ');
 
 	// Touchbar, if World Controller
 	if (supportsTouchbar()) {
@@ -167,23 +134,64 @@ void GuitarController_Shared::printDebug(Print& output) {
 		bluePrint = touchBlue() ? 'B' : fillCharacter;
 		orangePrint = touchOrange() ? 'O' : fillCharacter;
 
-		sprintf(buffer,
-			"Touch:%2u - %c%c%c%c%c | ",
-			touchbar(),
-			greenPrint, redPrint, yellowPrint, bluePrint, orangePrint);
-		output.print(buffer);
-		buffer[0] = 0;
+		output.print("Touch:");
+		printPadded(touchbar(), 2, output);
+		output.print(" - ");
+		output.print(greenPrint);
+		output.print(redPrint);
+		output.print(yellowPrint);
+		output.print(bluePrint);
+		output.print(orangePrint);
+		output.print(" | ");
 	}
 
 	// Joy + Plus/Minus
 	char plusPrint = buttonPlus() ? '+' : fillCharacter;
 	char minusPrint = buttonMinus() ? '-' : fillCharacter;
 
-	sprintf(buffer,
-		"%c%c | Joy:(%2u, %2u)",
-		minusPrint, plusPrint,
-		joyX(), joyY());
-	output.println(buffer);
+	output.print(minusPrint);
+	output.print(plusPrint);
+	output.print(" | Joy:(");
+	printPadded(joyX(), 2, output);
+	output.print(", ");
+	printPadded(joyY(), 2, output);
+	output.println(')');
+}
+
+const GuitarController_Shared::InputEngine::Frame & GuitarController_Shared::InputEngine::process() {
+	current.frets = guitar.fretMask();
+
+	const uint8_t touchValue = guitar.touchbar();
+	current.touch = touchValue != 31 ? TouchRegions[touchValue] : 0;  // 31 if no touchbar
+
+	const uint8_t fretsAll = current.frets | current.touch;
+	current.chord = chordTable != nullptr ? chordTable[fretsAll] : fretsAll;
+
+	// Strum events are rising edges, with any further changes ignored for
+	// a few frames afterwards so switch bounce doesn't register twice
+	const uint8_t strumNow = guitar.strumMask();
+	current.strum = 0;
+
+	if (lockout != 0) {
+		lockout--;
+	}
+	else {
+		current.strum = strumNow & ~lastStrum;
+		if (current.strum != 0) {
+			lockout = debounce;
+		}
+	}
+	lastStrum = strumNow;
+
+	return current;
+}
+
+void GuitarController_Shared::InputEngine::setChordTable(const uint8_t * table) {
+	chordTable = table;
+}
+
+void GuitarController_Shared::InputEngine::setDebounce(uint8_t frames) {
+	debounce = frames;
 }
 
 }  // End "NintendoExtensionCtrl" namespace
@@ -56,12 +56,26 @@ namespace NintendoExtensionCtrl {
 		GuitarController_Shared(ExtensionPort &port) :
 			GuitarController_Shared(port.getExtensionData()) {}
 
+		enum Fret : uint8_t {  // Bits for the packed fret and touchbar masks
+			Green = 0x01,
+			Red = 0x02,
+			Yellow = 0x04,
+			Blue = 0x08,
+			Orange = 0x10,
+		};
+
+		enum Strum : uint8_t {  // Bits for the packed strum mask
+			Up = 0x01,
+			Down = 0x02,
+		};
+
 		uint8_t joyX() const;  // 6 bits, 0-63
 		uint8_t joyY() const;
 
 		boolean strum() const;
 		boolean strumUp() const;
 		boolean strumDown() const;
+		uint8_t strumMask() const;  // 'Strum' bits
 
 		boolean fretGreen() const;
 		boolean fretRed() const;
@@ -69,6 +83,8 @@ namespace NintendoExtensionCtrl {
 		boolean fretBlue() const;
 		boolean fretOrange() const;
 
+		uint8_t fretMask() const;  // 'Fret' bits, all fret buttons at once
+
 		uint8_t whammyBar() const;  // 5 bits, 0-31 (starting at ~15-16)
 
 		uint8_t touchbar() const;  // 5 bits, 0-31
@@ -77,6 +93,7 @@ namespace NintendoExtensionCtrl {
 		boolean touchYellow() const;
 		boolean touchBlue() const;
 		boolean touchOrange() const;
+		uint8_t touchMask() const;  // 'Fret' bits, touchbar regions
 
 		boolean buttonPlus() const;
 		boolean buttonMinus() const;
@@ -85,11 +102,119 @@ namespace NintendoExtensionCtrl {
 
 		boolean supportsTouchbar();
 
+		class InputEngine {
+		public:
+			struct Frame {
+				uint8_t frets;  // 'Fret' bits, fret buttons
+				uint8_t touch;  // 'Fret' bits, touchbar regions
+				uint8_t strum;  // 'Strum' bits, only set on the frame a strum starts
+				uint8_t chord;  // Chord table entry for the combined frets, or the mask itself
+			};
+
+			InputEngine(GuitarController_Shared & controller, uint8_t debounceFrames = 2)
+				: guitar(controller), debounce(debounceFrames) {}
+
+			const Frame & process();  // Decode the latest data, call once per update
+			const Frame & frame() const { return current; }
+
+			void setChordTable(const uint8_t * table);  // 32 entries, indexed by fret mask
+			void setDebounce(uint8_t frames);  // Frames to ignore strum changes after a strum
+
+		private:
+			const GuitarController_Shared & guitar;
+			const uint8_t * chordTable = nullptr;
+
+			Frame current = { 0, 0, 0, 0 };
+			uint8_t lastStrum = 0;  // Raw strum bits from the previous frame
+			uint8_t lockout = 0;  // Frames left before another strum is accepted
+			uint8_t debounce;
+		};
+
 	private:
+		static const uint8_t TouchRegions[32];  // 'Fret' bits for each touchbar value
+
 		boolean touchbarData = false;  // Flag for touchbar data found
 	};
 }
 
+// Accessors, inlined with NXC_INLINE_ACCESSORS or built once in GuitarController.cpp
+#if NXC_INLINE_ACCESSORS || defined(NXC_GuitarController_cpp)
+namespace NintendoExtensionCtrl {
+	NXC_ACCESSOR uint8_t GuitarController_Shared::joyX() const {
+		return getControlData(Maps::JoyX);
+	}
+
+	NXC_ACCESSOR uint8_t GuitarController_Shared::joyY() const {
+		return getControlData(Maps::JoyY);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::strum() const {
+		return strumMask() != 0;
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::strumUp() const {
+		return getControlBit(Maps::StrumUp);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::strumDown() const {
+		return getControlBit(Maps::StrumDown);
+	}
+
+	NXC_ACCESSOR uint8_t GuitarController_Shared::strumMask() const {
+		// Up is bit 0 of byte 5, down is bit 6 of byte 4. Inverted, '0' is pressed.
+		return ((~getControlData(Maps::StrumUp.index) >> Maps::StrumUp.position) & Strum::Up) |
+			((~getControlData(Maps::StrumDown.index) >> (Maps::StrumDown.position - 1)) & Strum::Down);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::fretGreen() const {
+		return getControlBit(Maps::FretGreen);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::fretRed() const {
+		return getControlBit(Maps::FretRed);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::fretYellow() const {
+		return getControlBit(Maps::FretYellow);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::fretBlue() const {
+		return getControlBit(Maps::FretBlue);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::fretOrange() const {
+		return getControlBit(Maps::FretOrange);
+	}
+
+	NXC_ACCESSOR uint8_t GuitarController_Shared::fretMask() const {
+		// All frets share byte 5, in bits 3-7 as Y G B R O. Inverted, '0' is pressed.
+		const uint8_t raw = ~getControlData(5) >> 3;
+
+		return ((raw >> 1) & Fret::Green) |
+			((raw >> 2) & Fret::Red) |
+			((raw << 2) & Fret::Yellow) |
+			((raw << 1) & Fret::Blue) |
+			(raw & Fret::Orange);
+	}
+
+	NXC_ACCESSOR uint8_t GuitarController_Shared::whammyBar() const {
+		return getControlData(Maps::Whammy);
+	}
+
+	NXC_ACCESSOR uint8_t GuitarController_Shared::touchbar() const {
+		return getControlData(Maps::Touchbar);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::buttonPlus() const {
+		return getControlBit(Maps::ButtonPlus);
+	}
+
+	NXC_ACCESSOR boolean GuitarController_Shared::buttonMinus() const {
+		return getControlBit(Maps::ButtonMinus);
+	}
+}
+#endif
+
 using GuitarController = NintendoExtensionCtrl::BuildControllerClass
 	<NintendoExtensionCtrl::GuitarController_Shared>;
 
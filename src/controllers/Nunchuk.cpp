@@ -20,6 +20,7 @@
 *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#define NXC_Nunchuk_cpp  // Out-of-line accessors are built here
 #include "Nunchuk.h"
 
 namespace NintendoExtensionCtrl {
@@ -39,34 +40,6 @@ constexpr ByteMap   Nunchuk_Shared::Maps::AccelZ_LSB;
 constexpr BitMap    Nunchuk_Shared::Maps::ButtonC;
 constexpr BitMap    Nunchuk_Shared::Maps::ButtonZ;
 
-uint8_t Nunchuk_Shared::joyX() const {
-	return getControlData(Maps::JoyX);
-}
-
-uint8_t Nunchuk_Shared::joyY() const {
-	return getControlData(Maps::JoyY);
-}
-
-uint16_t Nunchuk_Shared::accelX() const {
-	return (getControlData(Maps::AccelX_MSB) << 2) | getControlData(Maps::AccelX_LSB);
-}
-
-uint16_t Nunchuk_Shared::accelY() const {
-	return (getControlData(Maps::AccelY_MSB) << 2) | getControlData(Maps::AccelY_LSB);
-}
-
-uint16_t Nunchuk_Shared::accelZ() const {
-	return (getControlData(Maps::AccelZ_MSB) << 2) | getControlData(Maps::AccelZ_LSB);
-}
-
-boolean Nunchuk_Shared::buttonC() const {
-	return getControlBit(Maps::ButtonC);
-}
-
-boolean Nunchuk_Shared::buttonZ() const {
-	return getControlBit(Maps::ButtonZ);
-}
-
 float Nunchuk_Shared::rollAngle() const {
 	return atan2((float)accelX() - 511.0, (float)accelZ() - 511.0) * 180.0 / PI;
 }
@@ -77,17 +50,22 @@ float Nunchuk_Shared::pitchAngle() const {
 }
 
 void Nunchuk_Shared::printDebug(Print& output) const {
-	char buffer[60];
-
 	char cPrint = buttonC() ? 'C' : '-';
 	char zPrint = buttonZ() ? 'Z' : '-';
 
-	output.print("Nunchuk - ");
-	sprintf(buffer,
-		"Joy:(%3u, %3u) | Accel XYZ:(%4u, %4u, %4u) | Buttons: %c%c",
-		joyX(), joyY(), accelX(), accelY(), accelZ(), cPrint, zPrint);
-
-	output.println(buffer);
+	output.print("Nunchuk - Joy:(");
+	printPadded(joyX(), 3, output);
+	output.print(", ");
+	printPadded(joyY(), 3, output);
+	output.print(") | Accel XYZ:(");
+	printPadded(accelX(), 4, output);
+	output.print(", ");
+	printPadded(accelY(), 4, output);
+	output.print(", ");
+	printPadded(accelZ(), 4, output);
+	output.print(") | Buttons: ");
+	output.print(cPrint);
+	output.println(zPrint);
 }
 
 }  // End "NintendoExtensionCtrl" namespace
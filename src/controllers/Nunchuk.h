@@ -68,6 +68,39 @@ namespace NintendoExtensionCtrl {
 	};
 }
 
+// Accessors, inlined with NXC_INLINE_ACCESSORS or built once in Nunchuk.cpp
+#if NXC_INLINE_ACCESSORS || defined(NXC_Nunchuk_cpp)
+namespace NintendoExtensionCtrl {
+	NXC_ACCESSOR uint8_t Nunchuk_Shared::joyX() const {
+		return getControlData(Maps::JoyX);
+	}
+
+	NXC_ACCESSOR uint8_t Nunchuk_Shared::joyY() const {
+		return getControlData(Maps::JoyY);
+	}
+
+	NXC_ACCESSOR uint16_t Nunchuk_Shared::accelX() const {
+		return (getControlData(Maps::AccelX_MSB) << 2) | getControlData(Maps::AccelX_LSB);
+	}
+
+	NXC_ACCESSOR uint16_t Nunchuk_Shared::accelY() const {
+		return (getControlData(Maps::AccelY_MSB) << 2) | getControlData(Maps::AccelY_LSB);
+	}
+
+	NXC_ACCESSOR uint16_t Nunchuk_Shared::accelZ() const {
+		return (getControlData(Maps::AccelZ_MSB) << 2) | getControlData(Maps::AccelZ_LSB);
+	}
+
+	NXC_ACCESSOR boolean Nunchuk_Shared::buttonC() const {
+		return getControlBit(Maps::ButtonC);
+	}
+
+	NXC_ACCESSOR boolean Nunchuk_Shared::buttonZ() const {
+		return getControlBit(Maps::ButtonZ);
+	}
+}
+#endif
+
 using Nunchuk = NintendoExtensionCtrl::BuildControllerClass
 	<NintendoExtensionCtrl::Nunchuk_Shared>;
 
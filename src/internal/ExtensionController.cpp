@@ -31,7 +31,7 @@ ExtensionController::ExtensionController(ExtensionData& dataRef, ExtensionType c
 	: id(conID), data(dataRef)  {}
 
 void ExtensionController::begin() {
-	data.i2c.begin();  // Initialize the bus
+	data.transport->begin(data.bus);  // Initialize the bus
 }
 
 boolean ExtensionController::connect() {
@@ -42,9 +42,16 @@ boolean ExtensionController::connect() {
 boolean ExtensionController::reconnect() {
 	boolean success = false;
 
-	if (initialize(data.i2c)) {
+	if (data.transport->initialize(data.bus)) {
+		data.frameSize = 0;  // Read fresh values, even if another view just did
 		identifyController();
 		success = update();  // Seed with initial values
+
+	#if NXC_ENABLE_STATS
+		if (success) {
+			data.stats.recordReconnect();
+		}
+	#endif
 	}
 	else {
 		data.connectedType = ExtensionType::NoController;  // Bad init, nothing connected
@@ -55,7 +62,20 @@ boolean ExtensionController::reconnect() {
 
 void ExtensionController::disconnect() {
 	data.connectedType = ExtensionType::NoController;  // Nothing connected
-	memset(&data.controlData, 0x00, ExtensionData::ControlDataSize);  // Clear control data
+	memset(&data.controlData, 0x00, sizeof(data.controlData));  // Clear control data
+	data.frameSize = 0;  // Nothing to reuse
+	data.debounce.reset();  // Re-seed the button filter from the next frame
+
+	data.fixup = nullptr;  // Belongs to the old controller
+	data.fixed = false;
+
+	if (filter != nullptr) {
+		filter->reset();  // Start from the new controller's values
+	}
+
+	if (events != nullptr) {
+		events->reset();  // Don't report the jump to the new controller's data
+	}
 }
 
 void ExtensionController::reset() {
@@ -64,7 +84,25 @@ void ExtensionController::reset() {
 }
 
 void ExtensionController::identifyController() {
-	data.connectedType = NintendoExtensionCtrl::identifyController(data.i2c);  // Polls the controller for its identity
+	uint8_t idData[ID_Size];
+	IdentityEntry entry;
+
+	if (!readIdentity(idData)) {
+		data.connectedType = ExtensionType::NoController;  // Bad response from device
+	}
+	else if (!findIdentity(idData, entry)) {
+		data.connectedType = ExtensionType::UnknownController;  // No matches
+	}
+	else {
+		data.connectedType = entry.type;
+
+		if (requestSize < entry.requestSize) {
+			setRequestSize(entry.requestSize);  // Smallest size the type needs
+		}
+		if (entry.init != nullptr && !entry.init(*this)) {
+			data.connectedType = ExtensionType::NoController;  // Setup failed, can't read it
+		}
+	}
 }
 
 boolean ExtensionController::controllerIDMatches() const {
@@ -82,20 +120,109 @@ ExtensionType ExtensionController::getControllerType() const {
 	return data.connectedType;
 }
 
+boolean ExtensionController::frameIsFresh() const {
+	// Another view of this port (or this one) read a frame that covers this
+	// view's request size, within the freshness window
+	return data.freshness != 0 &&
+		data.frameSize >= requestSize &&
+		micros() - data.frameTime < data.freshness;
+}
+
 boolean ExtensionController::update() {
-	if (controllerIDMatches() && requestControlData(data.i2c, requestSize, data.controlData)) {
-		return verifyData(data.controlData, requestSize);
+	if (controllerIDMatches() && frameIsFresh()) {
+		if (events != nullptr && lastSequence != data.sequence) {
+			events->dispatch(data.frontBuffer());  // First look at this frame for this view
+		}
+		lastSequence = data.sequence;
+
+	#if NXC_ENABLE_STATS
+		data.stats.recordCoalesced();
+	#endif
+		return true;  // Reuse it, no bus traffic
+	}
+
+	uint8_t * frame = startUpdate();
+	if (frame == nullptr) {
+		return false;  // Nothing to read from
+	}
+
+	uint8_t nBytesRecv = 0;
+	boolean pointerSet = false;
+	data.transport->readData(data.bus, 0x00, requestSize, frame, nBytesRecv, pointerSet);
+
+	return finishUpdate(nBytesRecv, pointerSet);
+}
+
+uint8_t * ExtensionController::startUpdate() {
+	if (!controllerIDMatches()) {
+		return nullptr;  // Nothing to read from
+	}
+
+#if NXC_ENABLE_STATS
+	updateStart = micros();
+#endif
+
+	NXC_TRACE_BEGIN(data, Update);
+
+	return data.backBuffer();  // Readers don't see it until the swap
+}
+
+boolean ExtensionController::finishUpdate(uint8_t nBytesRecv, boolean pointerSet) {
+	uint8_t * frame = data.backBuffer();
+	boolean success = (nBytesRecv == requestSize);  // Pointer set and all bytes received
+
+	if (success) {
+		NXC_TRACE_BEGIN(data, VerifyData);
+		success = verifyData(frame, requestSize);
+		NXC_TRACE_END(data, VerifyData);
+	}
+
+	if (success) {
+		if (data.fixup != nullptr) {
+			NXC_TRACE_BEGIN(data, KnockoffFixup);
+			data.fixed = data.fixup(frame);  // Raw data, before any filtering
+			NXC_TRACE_END(data, KnockoffFixup);
+		}
+
+		data.debounce.apply(frame, data.connectedType);
+
+		if (filter != nullptr) {
+			filter->apply(frame);
+		}
+
+		data.swapBuffers();  // Publish
+		data.frameSize = requestSize;
+		data.frameTime = micros();
+		lastSequence = data.sequence;
+
+		if (events != nullptr) {
+			events->dispatch(frame);
+		}
 	}
-	
-	return false;  // Something went wrong :(
+
+	NXC_TRACE_END(data, Update);
+
+#if NXC_ENABLE_STATS
+	data.stats.recordUpdate(success, pointerSet, nBytesRecv, requestSize, micros() - updateStart);
+#endif
+
+	return success;  // 'false' if something went wrong :(
 }
 
 uint8_t ExtensionController::getControlData(uint8_t controlIndex) const {
-	return data.controlData[controlIndex];
+	return data.frontBuffer()[controlIndex];
 }
 
 void ExtensionController::setControlData(uint8_t index, uint8_t val) {
-	data.controlData[index] = val;
+	data.frontBuffer()[index] = val;
+}
+
+void ExtensionController::attachFixup(ExtensionData::FrameFixup fn) {
+	data.fixup = fn;
+}
+
+boolean ExtensionController::frameFixed() const {
+	return data.fixed;
 }
 
 ExtensionController::ExtensionData & ExtensionController::getExtensionData() const {
@@ -108,8 +235,81 @@ void ExtensionController::setRequestSize(size_t r) {
 	}
 }
 
-NXC_I2C_TYPE & ExtensionController::i2c() const {
-	return data.i2c;
+uint8_t ExtensionController::getRequestSize() const {
+	return requestSize;
+}
+
+void ExtensionController::setDebounce(uint8_t frames) {
+	data.debounce.setDepth(frames);
+}
+
+void ExtensionController::setFreshness(uint16_t us) {
+	data.freshness = us;
+}
+
+uint16_t ExtensionController::getFreshness() const {
+	return data.freshness;
+}
+
+uint8_t ExtensionController::getSequence() const {
+	return data.sequence;
+}
+
+unsigned long ExtensionController::getFrameTime() const {
+	return data.frameTime;
+}
+
+#if NXC_ENABLE_ISR_SAFE
+
+void ExtensionController::readFrame(uint8_t * dataOut, uint8_t size) const {
+	if (size > ExtensionData::ControlDataSize) {
+		size = ExtensionData::ControlDataSize;
+	}
+
+	// Seqlock read: if update() published a new frame during the copy, copy
+	// again. Readers never block the interrupt, and never wait on it.
+	uint8_t seq;
+	do {
+		seq = data.sequence;
+		__asm__ __volatile__("" ::: "memory");  // Don't move the copy across the sequence reads
+		memcpy(dataOut, (const uint8_t *) data.controlData[data.front], size);
+		__asm__ __volatile__("" ::: "memory");
+	} while (seq != data.sequence);
+}
+#endif
+
+#if NXC_ENABLE_STATS
+NintendoExtensionCtrl::PortStats ExtensionController::getStats() const {
+	return data.stats;
+}
+
+void ExtensionController::resetStats() {
+	data.stats.reset();
+}
+#endif
+
+void ExtensionController::attachFilter(NintendoExtensionCtrl::AxisFilter & table) {
+	filter = &table;
+	filter->reset();
+}
+
+void ExtensionController::detachFilter() {
+	filter = nullptr;
+}
+
+void ExtensionController::attachEvents(NintendoExtensionCtrl::ControlEvents & table) {
+	events = &table;
+	events->reset();
+}
+
+void ExtensionController::detachEvents() {
+	events = nullptr;
+}
+
+boolean ExtensionController::readIdentity(uint8_t * idData) const {
+	uint8_t nBytesRecv;
+	boolean pointerSet;
+	return data.transport->readData(data.bus, 0xFA, ID_Size, idData, nBytesRecv, pointerSet);
 }
 
 void ExtensionController::printDebug(Print& output) const {
@@ -118,7 +318,7 @@ void ExtensionController::printDebug(Print& output) const {
 
 void ExtensionController::printDebugID(Print& output) const {
 	uint8_t idData[ID_Size];
-	boolean success = requestIdentity(data.i2c, idData);
+	boolean success = readIdentity(idData);
 
 	if (success) {
 		output.print("ID: ");
@@ -137,5 +337,5 @@ void ExtensionController::printDebugRaw(uint8_t baseFormat, Print& output) const
 	output.print("Raw[");
 	output.print(requestSize);
 	output.print("]: ");
-	printRaw(data.controlData, requestSize, baseFormat, output);
+	printRaw(data.frontBuffer(), requestSize, baseFormat, output);
 }
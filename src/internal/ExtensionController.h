@@ -23,10 +23,22 @@
 #ifndef NXC_ExtensionController_h
 #define NXC_ExtensionController_h
 
+#include "NXC_Config.h"
 #include "NXC_Identity.h"
 #include "NXC_Comms.h"
+#include "NXC_Transport.h"
 #include "NXC_Utils.h"
 #include "NXC_DataMaps.h"
+#include "NXC_Events.h"
+#include "NXC_AxisFilter.h"
+#include "NXC_Stats.h"
+
+// Accessor definitions in the controller headers, see NXC_INLINE_ACCESSORS
+#if NXC_INLINE_ACCESSORS
+#define NXC_ACCESSOR inline
+#else
+#define NXC_ACCESSOR
+#endif
 
 class ExtensionController {
 public:
@@ -34,14 +46,56 @@ public:
 		friend class ExtensionController;
 
 		ExtensionData(NXC_I2C_TYPE& i2cbus = NXC_I2C_DEFAULT) :
-			i2c(i2cbus) {}
+			bus(&i2cbus), transport(&NintendoExtensionCtrl::TransportPolicy<NXC_I2C_TYPE>::ops) {}
+
+		template<class Bus>
+		ExtensionData(Bus& i2cbus) :
+			bus(&i2cbus), transport(&NintendoExtensionCtrl::TransportPolicy<Bus>::ops) {}
 
 		static const uint8_t ControlDataSize = 21;  // Largest reporting mode (0x3d)
 
+		typedef boolean (*FrameFixup)(uint8_t * frame);  // Corrects a raw frame, 'true' if it changed it
+
+		const void * getBus() const { return bus; }  // Bus the port is on, for telling ports apart
+
+		template<class Bus>
+		boolean busIs() const { return transport == &NintendoExtensionCtrl::TransportPolicy<Bus>::ops; }  // Built with this bus type
+
 	protected:
-		NXC_I2C_TYPE & i2c;  // Reference for the I2C (Wire) class
+		void * const bus;  // I2C bus object (Wire, or any class with its interface)
+		const NintendoExtensionCtrl::Transport * const transport;  // Operations for that bus type
 		ExtensionType connectedType = ExtensionType::NoController;
+
+		volatile uint8_t sequence = 0;  // Frame generation, bumped for every good frame read
+		uint8_t frameSize = 0;          // Bytes in that frame, 0 if there's none to reuse
+		unsigned long frameTime = 0;    // micros() when it was read
+		uint16_t freshness = 0;         // Window in which update() reuses it, 0 for off
+
+		FrameFixup fixup = nullptr;     // Run by update() on each frame first, cleared on disconnect
+		volatile boolean fixed = false; // Whether it changed the latest frame
+
+	#if NXC_ENABLE_ISR_SAFE
+		uint8_t controlData[2][ControlDataSize];
+		volatile uint8_t front = 0;     // Buffer the accessors read, swapped by update()
+
+		const uint8_t * frontBuffer() const { return controlData[front]; }
+		uint8_t * frontBuffer() { return controlData[front]; }
+		uint8_t * backBuffer() { return controlData[front ^ 1]; }
+		void swapBuffers() { front ^= 1; sequence++; }
+	#else
 		uint8_t controlData[ControlDataSize];
+
+		const uint8_t * frontBuffer() const { return controlData; }
+		uint8_t * frontBuffer() { return controlData; }
+		uint8_t * backBuffer() { return controlData; }  // Updated in place
+		void swapBuffers() { sequence++; }
+	#endif
+
+		NintendoExtensionCtrl::ButtonDebounce debounce;  // Button filtering, shared by all views
+
+	#if NXC_ENABLE_STATS
+		NintendoExtensionCtrl::PortStats stats = {};
+	#endif
 	};
 
 	ExtensionController(ExtensionData& dataRef);
@@ -53,6 +107,15 @@ public:
 
 	boolean update();
 
+	// Update in two halves, for buses that transfer in the background (see
+	// SplitUpdate). startUpdate() gives the buffer to read 'getRequestSize()'
+	// bytes of control data into, or nullptr if there's nothing to read.
+	// finishUpdate() takes the number of bytes read and whether the pointer
+	// write was acknowledged, then verifies and publishes the frame the same
+	// way update() does.
+	uint8_t * startUpdate();
+	boolean finishUpdate(uint8_t nBytesRecv, boolean pointerSet = true);
+
 	void reset();
 
 	ExtensionType getControllerType() const;
@@ -60,6 +123,28 @@ public:
 	ExtensionData & getExtensionData() const;
 
 	void setRequestSize(size_t size = MinRequestSize);
+	uint8_t getRequestSize() const;
+	void setDebounce(uint8_t frames);  // Button debounce depth, 0 (off) to 7 frames
+	void setFreshness(uint16_t us);  // update() reuses a frame this new instead of reading, 0 for off
+	uint16_t getFreshness() const;
+
+	uint8_t getSequence() const;  // Changes whenever update() reads a new frame
+	unsigned long getFrameTime() const;  // micros() when the latest frame was read
+
+#if NXC_ENABLE_ISR_SAFE
+	void readFrame(uint8_t * dataOut, uint8_t size = MaxRequestSize) const;  // Consistent copy of the latest frame
+#endif
+
+#if NXC_ENABLE_STATS
+	NintendoExtensionCtrl::PortStats getStats() const;  // Snapshot of the port's counters
+	void resetStats();
+#endif
+
+	void attachFilter(NintendoExtensionCtrl::AxisFilter & table);  // Axis filtering run by update()
+	void detachFilter();
+
+	void attachEvents(NintendoExtensionCtrl::ControlEvents & table);  // Callbacks run by update()
+	void detachEvents();
 
 	void printDebug(Print& output = NXC_SERIAL_DEFAULT) const;
 	void printDebugID(Print& output = NXC_SERIAL_DEFAULT) const;
@@ -69,7 +154,12 @@ public:
 	static const uint8_t MinRequestSize = 6;   // Smallest reporting mode (0x37)
 	static const uint8_t MaxRequestSize = ExtensionData::ControlDataSize;
 
-	NXC_I2C_TYPE & i2c() const;  // Easily accessible I2C reference
+	NXC_I2C_TYPE & i2c() const { return busRef<NXC_I2C_TYPE>(); }  // I2C reference, halts if the port uses another bus type
+	template<class Bus = NXC_I2C_TYPE>
+	Bus * getBusAs() const {  // I2C bus, or nullptr if the port wasn't built with this type
+		return data.template busIs<Bus>() ? static_cast<Bus *>(data.bus) : nullptr;
+	}
+	boolean readIdentity(uint8_t * idData) const;  // Raw controller ID, 'ID_Size' bytes
 	const ExtensionType id = ExtensionType::AnyController;
 
 protected:
@@ -80,50 +170,79 @@ protected:
 	typedef NintendoExtensionCtrl::BitMap    BitMap;
 
 	uint8_t getControlData(const ByteMap map) const {
-		return (data.controlData[map.index] & map.mask) >> map.offset;
+		return (data.frontBuffer()[map.index] & map.mask) >> map.offset;
 	}
 
 	template<size_t size>
 	uint8_t getControlData(const ByteMap(&map)[size]) const {
+		const uint8_t * frame = data.frontBuffer();  // All parts from the same frame
 		uint8_t dataOut = 0x00;
 		for (size_t i = 0; i < size; i++) {
 			/* Repeated line from the single-ByteMap function above. Apparently the
 				constexpr stuff doesn't like being passed through nested functions. */
-			dataOut |= (data.controlData[map[i].index] & map[i].mask) >> map[i].offset;
+			dataOut |= (frame[map[i].index] & map[i].mask) >> map[i].offset;
 			//dataOut |= getControlData(map[i]);
 		}
 		return dataOut;
 	}
 
 	boolean getControlBit(const BitMap map) const {
-		return !(data.controlData[map.index] & (1 << map.position));  // Inverted logic, '0' is pressed
+		return !(data.frontBuffer()[map.index] & (1 << map.position));  // Inverted logic, '0' is pressed
 	}
 
 	void setControlData(uint8_t index, uint8_t val);
 
+	template<class Bus>
+	Bus & busRef() const {
+		Bus * bus = getBusAs<Bus>();
+		if (bus == nullptr) {
+			abort();  // Wrong bus type, there's no reference to return. Use getBusAs() to check first.
+		}
+		return *bus;
+	}
+
+	// Frame corrections run inside update(), on each raw frame before the
+	// debounce, axis filter and events see it. That also keeps them off the
+	// front buffer, which update() may be swapping from an interrupt.
+	void attachFixup(ExtensionData::FrameFixup fn);
+	boolean frameFixed() const;  // Whether the fixup changed the latest frame
+
 private:
 	ExtensionData &data;  // I2C and control data storage
 
 	void disconnect();
 	void identifyController();
 	boolean controllerIDMatches() const;
+	boolean frameIsFresh() const;
 
 	uint8_t requestSize = MinRequestSize;
+	uint8_t lastSequence = 0;  // Frame this view's events last saw
+
+#if NXC_ENABLE_STATS
+	unsigned long updateStart = 0;
+#endif
+	NintendoExtensionCtrl::AxisFilter * filter = nullptr;
+	NintendoExtensionCtrl::ControlEvents * events = nullptr;
 };
 
 namespace NintendoExtensionCtrl {
-	template <class ControllerMap>
+	// Controller class with its own data instance. The bus type defaults to
+	// the platform's Wire class, and can be any class with the same interface,
+	// e.g. BuildControllerClass<Nunchuk::Shared, SoftWire> nchuk(softBus);
+	template <class ControllerMap, class Bus = NXC_I2C_TYPE>
 	class BuildControllerClass : public ControllerMap {
 	public:
-		BuildControllerClass(NXC_I2C_TYPE& i2cBus = NXC_I2C_DEFAULT) :
+		BuildControllerClass(Bus& i2cBus = NXC_I2C_DEFAULT) :
 			ControllerMap(portData),
 			portData(i2cBus) {}
 
 		using Shared = ControllerMap;  // Make controller class easily accessible
 
+		Bus & i2c() const { return this->template busRef<Bus>(); }  // Easily accessible I2C reference, always of this type
+
 	protected:
 		// Included data instance. Contains:
-		//    * I2C library object reference
+		//    * I2C bus reference, and the transport for its type
 		//    * Connected controller identity (type)
 		//    * Control data array
 		// This data can be shared between controller instances using a single
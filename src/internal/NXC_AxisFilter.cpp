@@ -0,0 +1,125 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_AxisFilter.h"
+
+namespace NintendoExtensionCtrl {
+
+	boolean AxisFilter::add(const ByteMap map, uint8_t band, uint8_t deadzone, uint16_t center) {
+		Axis * axis = create(band, deadzone, center);
+		if (axis == nullptr) { return false; }
+
+		addPart(*axis, map.index, map.mask, map.offset);
+		return true;
+	}
+
+	boolean AxisFilter::add(CtrlIndex index, uint8_t band, uint8_t deadzone, uint16_t center) {
+		return add(ByteMap(index, 8, 0, 0), band, deadzone, center);
+	}
+
+	boolean AxisFilter::add(CtrlIndex msb, const ByteMap lsb, uint8_t band, uint8_t deadzone, uint16_t center) {
+		Axis * axis = create(band, deadzone, center);
+		if (axis == nullptr) { return false; }
+
+		// MSB sits above however many bits the LSB map holds
+		uint8_t lsbBits = 0;
+		for (uint8_t m = lsb.mask; m != 0; m >>= 1) {
+			lsbBits += m & 0x01;
+		}
+
+		addPart(*axis, msb, 0xFF, -lsbBits);
+		addPart(*axis, lsb.index, lsb.mask, lsb.offset);
+		return true;
+	}
+
+	AxisFilter::Axis * AxisFilter::create(uint8_t band, uint8_t deadzone, uint16_t center) {
+		if (count >= capacity) {
+			return nullptr;  // Table full
+		}
+
+		Axis & axis = axes[count++];
+		axis.numParts = 0;
+		axis.band = band;
+		axis.deadzone = deadzone;
+		axis.center = center;
+		axis.held = center;
+
+		seeded = false;  // Pick up the new axis' value on the next frame
+		return &axis;
+	}
+
+	void AxisFilter::addPart(Axis & axis, uint8_t index, uint8_t mask, int8_t shift) {
+		Part & p = axis.parts[axis.numParts++];
+		p.index = index;
+		p.mask = mask;
+		p.shift = shift;
+	}
+
+	void AxisFilter::clear() {
+		count = 0;
+	}
+
+	void AxisFilter::reset() {
+		seeded = false;
+	}
+
+	uint16_t AxisFilter::readAxis(const Axis & axis, const uint8_t * controlData) {
+		uint16_t value = 0;
+		for (uint8_t i = 0; i < axis.numParts; i++) {
+			const Part & p = axis.parts[i];
+			const uint16_t bits = controlData[p.index] & p.mask;
+			value |= p.shift >= 0 ? bits >> p.shift : bits << -p.shift;
+		}
+		return value;
+	}
+
+	void AxisFilter::writeAxis(const Axis & axis, uint8_t * controlData) {
+		for (uint8_t i = 0; i < axis.numParts; i++) {
+			const Part & p = axis.parts[i];
+			const uint8_t bits = (p.shift >= 0 ? axis.held << p.shift : axis.held >> -p.shift) & p.mask;
+			controlData[p.index] = (controlData[p.index] & ~p.mask) | bits;
+		}
+	}
+
+	boolean AxisFilter::apply(uint8_t * controlData) {
+		lastChanged = false;
+
+		for (uint8_t i = 0; i < count; i++) {
+			Axis & axis = axes[i];
+			uint16_t value = readAxis(axis, controlData);
+
+			if (abs((int16_t) value - (int16_t) axis.center) <= axis.deadzone) {
+				value = axis.center;  // Inside the deadzone, snap to center
+			}
+
+			if (!seeded || abs((int16_t) value - (int16_t) axis.held) > axis.band) {
+				lastChanged |= (value != axis.held);
+				axis.held = value;  // Moved out of the band, take the new value
+			}
+
+			writeAxis(axis, controlData);
+		}
+
+		seeded = true;
+		return lastChanged;
+	}
+}
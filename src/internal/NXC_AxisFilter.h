@@ -0,0 +1,114 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_AxisFilter_h
+#define NXC_AxisFilter_h
+
+#include "Arduino.h"
+#include "NXC_DataMaps.h"
+
+namespace NintendoExtensionCtrl {
+	// Per-axis deadzone and hysteresis, run on the control data during update().
+	// An axis only takes a new value once it moves more than 'band' away from the
+	// value it's holding, and the held value is written back into the control
+	// data so the normal accessors (and any events) only see the filtered values.
+	// It runs after the port's frame fixup, so a knockoff's frame is filtered
+	// once it's corrected. Storage is provided by 'AxisFilterTable' below.
+	class AxisFilter {
+	public:
+		// Single byte or partial byte values (sticks, whammy, crossfader)
+		boolean add(const ByteMap map, uint8_t band, uint8_t deadzone = 0, uint16_t center = 0);
+		boolean add(CtrlIndex index, uint8_t band, uint8_t deadzone = 0, uint16_t center = 0);
+
+		// Values split across bytes (Classic right joystick X, triggers)
+		template<size_t size>
+		boolean add(const ByteMap(&map)[size], uint8_t band, uint8_t deadzone = 0, uint16_t center = 0) {
+			static_assert(size <= MaxParts, "Too many parts for a filtered axis");
+
+			Axis * axis = create(band, deadzone, center);
+			if (axis == nullptr) { return false; }
+
+			for (size_t i = 0; i < size; i++) {
+				addPart(*axis, map[i].index, map[i].mask, map[i].offset);
+			}
+			return true;
+		}
+
+		// High byte + low bits values, such as the 10-bit Nunchuk accelerometer
+		boolean add(CtrlIndex msb, const ByteMap lsb, uint8_t band, uint8_t deadzone = 0, uint16_t center = 0);
+
+		void clear();  // Remove all axes
+		uint8_t size() const { return count; }
+
+		boolean apply(uint8_t * controlData);  // Returns 'true' if any filtered value moved
+		boolean changed() const { return lastChanged; }
+
+		void reset();  // Next frame is taken as-is
+
+		static const uint8_t MaxParts = 3;
+
+	protected:
+		struct Part {
+			uint8_t index;  // Control data byte
+			uint8_t mask;   // Bits within that byte
+			int8_t shift;   // Right shift to the value position, negative for left
+		};
+
+		struct Axis {
+			Part parts[MaxParts];
+			uint8_t numParts;
+
+			uint8_t band;
+			uint8_t deadzone;
+			uint16_t center;
+			uint16_t held;  // Filtered value, written back to the data
+		};
+
+		AxisFilter(Axis * table, uint8_t tableSize) :
+			axes(table), capacity(tableSize) {}
+
+	private:
+		Axis * create(uint8_t band, uint8_t deadzone, uint16_t center);
+		static void addPart(Axis & axis, uint8_t index, uint8_t mask, int8_t shift);
+
+		static uint16_t readAxis(const Axis & axis, const uint8_t * controlData);
+		static void writeAxis(const Axis & axis, uint8_t * controlData);
+
+		Axis * const axes;
+		const uint8_t capacity;
+		uint8_t count = 0;
+
+		boolean seeded = false;  // Whether the 'held' values are valid
+		boolean lastChanged = false;
+	};
+
+	template<uint8_t Size>
+	class AxisFilterTable : public AxisFilter {
+	public:
+		AxisFilterTable() : AxisFilter(table, Size) {}
+
+	private:
+		Axis table[Size];
+	};
+}
+
+#endif
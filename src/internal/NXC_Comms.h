@@ -25,6 +25,7 @@
 
 #include "Arduino.h"
 #include "NXC_Identity.h"
+#include "NXC_Trace.h"
 
 #if defined(__MK20DX128__) || defined(__MK20DX256__) || defined(__MKL26Z64__) || \
     defined(__MK64FX512__) || defined(__MK66FX1M0__) // Teensy 3.0/3.1-3.2/LC/3.5/3.6
@@ -42,40 +43,77 @@ namespace NintendoExtensionCtrl {
 	const long I2C_ConversionDelay = 175;  // Microseconds, ~200 on AVR
 	const uint8_t I2C_Addr = 0x52;  // Address for all extension controllers
 
-	const uint8_t ID_Size = 6;
-
 	// Generic I2C slave device control functions
 	// ------------------------------------------
-	inline boolean i2c_writePointer(NXC_I2C_TYPE &i2c, byte addr, byte ptr) {
+	// These take any bus with the Wire interface: begin(), beginTransmission(),
+	// write(), endTransmission(), requestFrom(), and readBytes(). They're
+	// templates so each transaction is built for the concrete bus type.
+	template<class Bus>
+	inline boolean i2c_writePointer(Bus &i2c, byte addr, byte ptr) {
 		i2c.beginTransmission(addr);
 		i2c.write(ptr);
 		return i2c.endTransmission() == 0;  // 0 = No Error
 	}
 
-	inline boolean i2c_writeRegister(NXC_I2C_TYPE &i2c, byte addr, byte reg, byte value) {
+	template<class Bus>
+	inline boolean i2c_writeRegister(Bus &i2c, byte addr, byte reg, byte value) {
 		i2c.beginTransmission(addr);
 		i2c.write(reg);
 		i2c.write(value);
 		return i2c.endTransmission() == 0;
 	}
 
-	inline boolean i2c_requestMultiple(NXC_I2C_TYPE &i2c, byte addr, uint8_t requestSize, uint8_t * dataOut) {
-		uint8_t nBytesRecv = i2c.readBytes(dataOut,
-			i2c.requestFrom(addr, requestSize));
+	template<class Bus>
+	inline boolean i2c_requestMultiple(Bus &i2c, byte addr, uint8_t requestSize, uint8_t * dataOut, uint8_t &nBytesRecv) {
+		NXC_TRACE_BUS_BEGIN(&i2c, RequestFrom);
+		const uint8_t nBytesAvailable = i2c.requestFrom(addr, requestSize);
+		NXC_TRACE_BUS_END(&i2c, RequestFrom);
+
+		NXC_TRACE_BUS_BEGIN(&i2c, ReadBytes);
+		nBytesRecv = i2c.readBytes(dataOut, nBytesAvailable);
+		NXC_TRACE_BUS_END(&i2c, ReadBytes);
 
 		return (nBytesRecv == requestSize);  // Success if all bytes received
 	}
 
-	inline boolean i2c_readDataArray(NXC_I2C_TYPE &i2c, byte addr, byte ptr, uint8_t requestSize, uint8_t * dataOut) {
-		if (!i2c_writePointer(i2c, addr, ptr)) { return false; }  // Set start for data read
+	template<class Bus>
+	inline boolean i2c_requestMultiple(Bus &i2c, byte addr, uint8_t requestSize, uint8_t * dataOut) {
+		uint8_t nBytesRecv;
+		return i2c_requestMultiple(i2c, addr, requestSize, dataOut, nBytesRecv);
+	}
+
+	template<class Bus>
+	inline boolean i2c_readDataArray(Bus &i2c, byte addr, byte ptr, uint8_t requestSize, uint8_t * dataOut, uint8_t &nBytesRecv, boolean &pointerSet) {
+		nBytesRecv = 0;
+		NXC_TRACE_BUS_BEGIN(&i2c, PointerWrite);
+		pointerSet = i2c_writePointer(i2c, addr, ptr);  // Set start for data read
+		NXC_TRACE_BUS_END(&i2c, PointerWrite);
+		if (!pointerSet) { return false; }
+
+		NXC_TRACE_BUS_BEGIN(&i2c, ConversionWait);
 		delayMicroseconds(I2C_ConversionDelay);  // Wait for data conversion
-		return i2c_requestMultiple(i2c, addr, requestSize, dataOut);
+		NXC_TRACE_BUS_END(&i2c, ConversionWait);
+
+		return i2c_requestMultiple(i2c, addr, requestSize, dataOut, nBytesRecv);
+	}
+
+	template<class Bus>
+	inline boolean i2c_readDataArray(Bus &i2c, byte addr, byte ptr, uint8_t requestSize, uint8_t * dataOut, uint8_t &nBytesRecv) {
+		boolean pointerSet;
+		return i2c_readDataArray(i2c, addr, ptr, requestSize, dataOut, nBytesRecv, pointerSet);
+	}
+
+	template<class Bus>
+	inline boolean i2c_readDataArray(Bus &i2c, byte addr, byte ptr, uint8_t requestSize, uint8_t * dataOut) {
+		uint8_t nBytesRecv;
+		return i2c_readDataArray(i2c, addr, ptr, requestSize, dataOut, nBytesRecv);
 	}
 
 	// Extension controller specific I2C functions
 	// -------------------------------------------
 	// Control Data
-	inline boolean initialize(NXC_I2C_TYPE &i2c) {
+	template<class Bus>
+	inline boolean initialize(Bus &i2c) {
 		/* Initialization for unencrypted communication.
 		* *Should* work on all devices, genuine + 3rd party.
 		* See http://wiibrew.org/wiki/Wiimote/Extension_Controllers
@@ -87,16 +125,24 @@ namespace NintendoExtensionCtrl {
 		return true;
 	}
 
-	inline boolean requestData(NXC_I2C_TYPE &i2c, uint8_t ptr, size_t size, uint8_t * data) {
+	template<class Bus>
+	inline boolean requestData(Bus &i2c, uint8_t ptr, size_t size, uint8_t * data) {
 		return i2c_readDataArray(i2c, I2C_Addr, ptr, size, data);
 	}
 
-	inline boolean requestControlData(NXC_I2C_TYPE &i2c, size_t size, uint8_t * controlData) {
+	template<class Bus>
+	inline boolean requestControlData(Bus &i2c, size_t size, uint8_t * controlData) {
 		return i2c_readDataArray(i2c, I2C_Addr, 0x00, size, controlData);
 	}
 
+	template<class Bus>
+	inline boolean requestControlData(Bus &i2c, size_t size, uint8_t * controlData, uint8_t &nBytesRecv) {
+		return i2c_readDataArray(i2c, I2C_Addr, 0x00, size, controlData, nBytesRecv);
+	}
+
 	// Identity
-	inline boolean requestIdentity(NXC_I2C_TYPE &i2c, uint8_t * idData) {
+	template<class Bus>
+	inline boolean requestIdentity(Bus &i2c, uint8_t * idData) {
 		return i2c_readDataArray(i2c, I2C_Addr, 0xFA, ID_Size, idData);
 	}
 
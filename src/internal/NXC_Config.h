@@ -0,0 +1,74 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Config_h
+#define NXC_Config_h
+
+// Library build options. Change them here, or define them for the whole
+// build (e.g. with -D flags) to override the defaults. Defining them in a
+// sketch before the #include is not enough, as the library's own source
+// files would be built with different settings.
+
+// Per-port statistics: update/error counters, bytes moved, and a histogram
+// of update() times. Adds 64 bytes of RAM per port and a micros() call per
+// update when enabled.
+#ifndef NXC_ENABLE_STATS
+#define NXC_ENABLE_STATS 0
+#endif
+
+// Phase tracing: timestamped begin/end records for each step of an update
+// (pointer write, conversion wait, request, read, verify, knockoff fixup),
+// kept in a static ring buffer of NXC_TRACE_SIZE records. The size must be
+// a power of two. Each record is 6 bytes plus two pointers.
+#ifndef NXC_ENABLE_TRACE
+#define NXC_ENABLE_TRACE 0
+#endif
+
+#ifndef NXC_TRACE_SIZE
+#define NXC_TRACE_SIZE 64
+#endif
+
+// Interrupt-safe ports: control data is double buffered, so update() can run
+// from a timer interrupt while the main loop reads. update() fills the back
+// buffer and publishes it with a one-byte index swap, and accessors read
+// from the front buffer. Use readFrame() for a consistent copy of a whole
+// frame. Corrections like the NES knockoff fixup run inside update(), on
+// the back buffer. Adds 22 bytes of RAM per port on AVR. The I2C library
+// still has to work from the interrupt: on AVR re-enable interrupts first
+// thing in the ISR so TWI can run, and on Teensy give the timer a lower
+// priority than I2C.
+#ifndef NXC_ENABLE_ISR_SAFE
+#define NXC_ENABLE_ISR_SAFE 0
+#endif
+
+// Inline accessors: the simple control getters (joysticks, buttons, etc.)
+// are defined in the controller headers, so each call compiles down to a
+// load, mask and compare at the call site. Without it they are built once
+// in the controller's .cpp and every access is a function call, which only
+// link-time optimization can remove. Usually faster and often smaller for
+// sketches that read a few controls, but each call site carries its own
+// copy of the code.
+#ifndef NXC_INLINE_ACCESSORS
+#define NXC_INLINE_ACCESSORS 0
+#endif
+
+#endif
@@ -0,0 +1,168 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Events.h"
+
+namespace NintendoExtensionCtrl {
+
+	boolean ControlEvents::onPress(const BitMap map, ButtonCallback fn) {
+		const Part part = { map.index, (uint8_t) (1 << map.position), 0 };
+		Handler * h = add(&part, 1, EventType::Press);
+		if (h == nullptr) { return false; }
+
+		h->fn.button = fn;
+		return true;
+	}
+
+	boolean ControlEvents::onRelease(const BitMap map, ButtonCallback fn) {
+		const Part part = { map.index, (uint8_t) (1 << map.position), 0 };
+		Handler * h = add(&part, 1, EventType::Release);
+		if (h == nullptr) { return false; }
+
+		h->fn.button = fn;
+		return true;
+	}
+
+	boolean ControlEvents::onAxisChange(const ByteMap map, uint8_t threshold, AxisCallback fn) {
+		const Part part = { map.index, map.mask, (int8_t) map.offset };
+		return addAxis(&part, 1, threshold, fn);
+	}
+
+	boolean ControlEvents::onAxisChange(CtrlIndex index, uint8_t threshold, AxisCallback fn) {
+		return onAxisChange(ByteMap(index, 8, 0, 0), threshold, fn);
+	}
+
+	boolean ControlEvents::onAxisChange(CtrlIndex msb, const ByteMap lsb, uint8_t threshold, AxisCallback fn) {
+		// MSB sits above however many bits the LSB map holds
+		int8_t lsbBits = 0;
+		for (uint8_t m = lsb.mask; m != 0; m >>= 1) {
+			lsbBits += m & 0x01;
+		}
+
+		const Part parts[2] = {
+			{ msb, 0xFF, (int8_t) -lsbBits },
+			{ lsb.index, lsb.mask, (int8_t) lsb.offset },
+		};
+		return addAxis(parts, 2, threshold, fn);
+	}
+
+	boolean ControlEvents::addAxis(const Part * parts, uint8_t numParts, uint8_t threshold, AxisCallback fn) {
+		Handler * h = add(parts, numParts, EventType::Axis);
+		if (h == nullptr) { return false; }
+
+		h->threshold = threshold > 0 ? threshold : 1;
+		h->fn.axis = fn;
+		return true;
+	}
+
+	ControlEvents::Handler * ControlEvents::add(const Part * parts, uint8_t numParts, EventType type) {
+		if (count >= capacity) {
+			return nullptr;  // Table full
+		}
+		for (uint8_t i = 0; i < numParts; i++) {
+			if (parts[i].index >= DiffSize) return nullptr;  // Outside of the compared data
+		}
+
+		Handler & h = handlers[count++];
+		for (uint8_t i = 0; i < numParts; i++) {
+			h.parts[i] = parts[i];
+		}
+		h.numParts = numParts;
+		h.type = type;
+		h.threshold = 0;
+		h.lastValue = seeded ? readValue(h, lastData) : 0;
+
+		return &h;
+	}
+
+	uint16_t ControlEvents::readValue(const Handler & h, const uint8_t * controlData) {
+		uint16_t value = 0;
+		for (uint8_t i = 0; i < h.numParts; i++) {
+			const Part & p = h.parts[i];
+			const uint16_t bits = controlData[p.index] & p.mask;
+			value |= p.shift >= 0 ? bits >> p.shift : bits << -p.shift;
+		}
+		return value;
+	}
+
+	void ControlEvents::clear() {
+		count = 0;
+	}
+
+	void ControlEvents::reset() {
+		seeded = false;
+	}
+
+	void ControlEvents::dispatch(const uint8_t * controlData) {
+		uint8_t diff[DiffSize];
+		uint8_t changed = 0x00;
+
+		for (uint8_t i = 0; i < DiffSize; i++) {
+			diff[i] = controlData[i] ^ lastData[i];
+			changed |= diff[i];
+			lastData[i] = controlData[i];
+		}
+
+		if (!seeded) {  // Baseline frame, set axis values and stop
+			for (uint8_t i = 0; i < count; i++) {
+				Handler & h = handlers[i];
+				h.lastValue = readValue(h, controlData);
+			}
+			seeded = true;
+			return;
+		}
+
+		if (changed == 0x00) {
+			return;  // Nothing to do
+		}
+
+		for (uint8_t i = 0; i < count; i++) {
+			Handler & h = handlers[i];
+
+			uint8_t moved = 0x00;
+			for (uint8_t p = 0; p < h.numParts; p++) {
+				moved |= diff[h.parts[p].index] & h.parts[p].mask;
+			}
+			if (moved == 0x00) {
+				continue;  // No change for this control
+			}
+
+			switch (h.type) {
+				case(EventType::Press):
+					if ((controlData[h.parts[0].index] & h.parts[0].mask) == 0) h.fn.button();  // Inverted logic, '0' is pressed
+					break;
+				case(EventType::Release):
+					if ((controlData[h.parts[0].index] & h.parts[0].mask) != 0) h.fn.button();
+					break;
+				case(EventType::Axis):
+				{
+					const uint16_t value = readValue(h, controlData);
+					if (abs((int16_t) value - (int16_t) h.lastValue) >= h.threshold) {
+						h.lastValue = value;
+						h.fn.axis(value);
+					}
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,122 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Events_h
+#define NXC_Events_h
+
+#include "Arduino.h"
+#include "NXC_DataMaps.h"
+
+namespace NintendoExtensionCtrl {
+	// Callback table for control changes. Every update the first bytes of control
+	// data are XOR'd against the previous frame, and only the handlers whose bits
+	// changed are looked at. Storage is provided by 'ControlEventTable' below,
+	// so the size is fixed at compile time and nothing is allocated.
+	class ControlEvents {
+	public:
+		typedef void (*ButtonCallback)();
+		typedef void (*AxisCallback)(uint16_t value);
+
+		boolean onPress(const BitMap map, ButtonCallback fn);
+		boolean onRelease(const BitMap map, ButtonCallback fn);
+
+		// Single byte or partial byte values (sticks, whammy, crossfader)
+		boolean onAxisChange(const ByteMap map, uint8_t threshold, AxisCallback fn);
+		boolean onAxisChange(CtrlIndex index, uint8_t threshold, AxisCallback fn);
+
+		// Values split across bytes (Classic right joystick X, triggers, turntables)
+		template<size_t size>
+		boolean onAxisChange(const ByteMap(&map)[size], uint8_t threshold, AxisCallback fn) {
+			static_assert(size <= MaxParts, "Too many parts for an axis event");
+
+			Part parts[size];
+			for (size_t i = 0; i < size; i++) {
+				parts[i] = { map[i].index, map[i].mask, (int8_t) map[i].offset };
+			}
+			return addAxis(parts, size, threshold, fn);
+		}
+
+		// High byte + low bits values, such as the 10-bit Nunchuk accelerometer
+		boolean onAxisChange(CtrlIndex msb, const ByteMap lsb, uint8_t threshold, AxisCallback fn);
+
+		void clear();  // Remove all handlers
+		uint8_t size() const { return count; }
+
+		void dispatch(const uint8_t * controlData);
+		void reset();  // Next frame is taken as the baseline, no callbacks
+
+		static const uint8_t DiffSize = 6;  // Bytes compared per frame, covers all maps
+		static const uint8_t MaxParts = 3;
+
+	protected:
+		enum class EventType : uint8_t {
+			Press,
+			Release,
+			Axis,
+		};
+
+		struct Part {
+			uint8_t index;  // Control data byte
+			uint8_t mask;   // Control bits within that byte
+			int8_t shift;   // Right shift to the value position, negative for left
+		};
+
+		struct Handler {
+			Part parts[MaxParts];
+			uint8_t numParts;
+			EventType type;
+			uint8_t threshold;   // Minimum axis change to report
+			uint16_t lastValue;  // Last axis value reported
+			union {
+				ButtonCallback button;
+				AxisCallback axis;
+			} fn;
+		};
+
+		ControlEvents(Handler * table, uint8_t tableSize) :
+			handlers(table), capacity(tableSize) {}
+
+	private:
+		Handler * add(const Part * parts, uint8_t numParts, EventType type);
+		boolean addAxis(const Part * parts, uint8_t numParts, uint8_t threshold, AxisCallback fn);
+
+		static uint16_t readValue(const Handler & h, const uint8_t * controlData);
+
+		Handler * const handlers;
+		const uint8_t capacity;
+		uint8_t count = 0;
+
+		uint8_t lastData[DiffSize];
+		boolean seeded = false;  // Whether 'lastData' holds a valid frame
+	};
+
+	template<uint8_t Size>
+	class ControlEventTable : public ControlEvents {
+	public:
+		ControlEventTable() : ControlEvents(table, Size) {}
+
+	private:
+		Handler table[Size];
+	};
+}
+
+#endif
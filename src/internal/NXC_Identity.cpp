@@ -0,0 +1,89 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Identity.h"
+#include "ExtensionController.h"
+
+namespace NintendoExtensionCtrl {
+	// All valid IDs have 0xA420 in the middle. Nunchuks and Classic Controllers
+	// are told apart by the last two bytes, and the Guitar Hero controllers
+	// (0x##00 A420 0103) by the first.
+	static const IdentityEntry LibraryIdentities[] PROGMEM = {
+		{ { 0x00, 0x00, 0xA4, 0x20, 0x00, 0x00 }, { 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF },
+			ExtensionType::Nunchuk, ExtensionController::MinRequestSize, nullptr },
+		{ { 0x00, 0x00, 0xA4, 0x20, 0x01, 0x01 }, { 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF },
+			ExtensionType::ClassicController, ExtensionController::MinRequestSize, nullptr },
+		{ { 0x00, 0x00, 0xA4, 0x20, 0x01, 0x03 }, { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+			ExtensionType::GuitarController, ExtensionController::MinRequestSize, nullptr },
+		{ { 0x01, 0x00, 0xA4, 0x20, 0x01, 0x03 }, { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+			ExtensionType::DrumController, ExtensionController::MinRequestSize, nullptr },
+		{ { 0x03, 0x00, 0xA4, 0x20, 0x01, 0x03 }, { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+			ExtensionType::DJTurntableController, ExtensionController::MinRequestSize, nullptr },
+	};
+
+	__attribute__((weak)) const IdentityEntry * userIdentities(uint8_t & count) {
+		count = 0;
+		return nullptr;
+	}
+
+	static boolean matches(const IdentityEntry & entry, const uint8_t * idData) {
+		for (uint8_t i = 0; i < ID_Size; i++) {
+			if ((idData[i] & entry.mask[i]) != entry.id[i]) return false;
+		}
+		return true;
+	}
+
+	static boolean matches_P(const IdentityEntry * entry, const uint8_t * idData) {
+		for (uint8_t i = 0; i < ID_Size; i++) {
+			if ((idData[i] & pgm_read_byte(&entry->mask[i])) != pgm_read_byte(&entry->id[i])) return false;
+		}
+		return true;
+	}
+
+	boolean findIdentity(const uint8_t * idData, IdentityEntry & entry) {
+		uint8_t count = 0;
+		const IdentityEntry * user = userIdentities(count);
+		for (uint8_t i = 0; i < count; i++) {
+			if (matches(user[i], idData)) {
+				entry = user[i];
+				return true;
+			}
+		}
+
+		for (const IdentityEntry & e : LibraryIdentities) {
+			if (matches_P(&e, idData)) {
+				memcpy_P(&entry, &e, sizeof(IdentityEntry));
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	ExtensionType identifyController(const uint8_t * idData) {
+		IdentityEntry entry;
+		if (findIdentity(idData, entry)) {
+			return entry.type;
+		}
+		return ExtensionType::UnknownController;  // No matches
+	}
+}
@@ -25,6 +25,8 @@
 
 #include "Arduino.h"
 
+class ExtensionController;
+
 enum class ExtensionType {
 	NoController,
 	AnyController,
@@ -37,39 +39,44 @@ enum class ExtensionType {
 };
 
 namespace NintendoExtensionCtrl {
-	inline ExtensionType identifyController(const uint8_t * idData) {
-		if (idData[2] == 0xA4 && idData[3] == 0x20) {  // All valid IDs
-			// Nunchuk ID: 0x0000
-			if (idData[4] == 0x00 && idData[5] == 0x00) {
-				return ExtensionType::Nunchuk;
-			}
+	const uint8_t ID_Size = 6;
 
-			// Classic Con. ID: 0x0101
-			else if (idData[4] == 0x01 && idData[5] == 0x01) {
-				return ExtensionType::ClassicController;
-			}
+	// A known controller identity. The 6 ID bytes read from 0xFA are ANDed
+	// with 'mask' and compared to 'id', so bits that vary between units can
+	// be ignored. On connect, the port's request size is raised to at least
+	// 'requestSize' and 'init' is run, if set. A false return from 'init'
+	// fails the connection.
+	struct IdentityEntry {
+		uint8_t id[ID_Size];
+		uint8_t mask[ID_Size];
+		ExtensionType type;
+		uint8_t requestSize;
+		boolean (*init)(ExtensionController & port);
+	};
 
-			// Guitar Hero Controllers: 0x##00, 0xA420, 0x0103
-			else if (idData[1] == 0x00
-				&& idData[4] == 0x01 && idData[5] == 0x03) {
+	// Looks the ID up in the user's entries and then the library's, and
+	// copies out the first match. The library's entries are kept in flash.
+	boolean findIdentity(const uint8_t * idData, IdentityEntry & entry);
+	ExtensionType identifyController(const uint8_t * idData);
 
-				// Guitar: 0x00
-				if (idData[0] == 0x00) {
-					return ExtensionType::GuitarController;
-				}
-				// Drums: 0x01
-				else if (idData[0] == 0x01) {
-					return ExtensionType::DrumController;
-				}
-				// DJ Turntable: 0x03
-				else if (idData[0] == 0x03) {
-					return ExtensionType::DJTurntableController;
-				}
-			}
-		}
+	// Entries to check before the library's, for controllers it doesn't know
+	// or to override the ones it does. The library has an empty default, and
+	// a sketch replaces it with NXC_USER_IDENTITIES(table):
+	//
+	//   const NintendoExtensionCtrl::IdentityEntry MyControllers[] = {
+	//       { { 0x00, 0x00, 0xA4, 0x20, 0x01, 0x11 }, { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+	//         (ExtensionType) 0x40, 6, nullptr },  // Taiko drum
+	//   };
+	//   NXC_USER_IDENTITIES(MyControllers)
+	//
+	// Types the library doesn't have can use any value past the enum's.
+	const IdentityEntry * userIdentities(uint8_t & count);
+}
 
-		return ExtensionType::UnknownController;  // No matches
+#define NXC_USER_IDENTITIES(table) \
+	const NintendoExtensionCtrl::IdentityEntry * NintendoExtensionCtrl::userIdentities(uint8_t & count) { \
+		count = sizeof(table) / sizeof(table[0]); \
+		return table; \
 	}
-}
 
 #endif
@@ -0,0 +1,76 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Stats.h"
+
+namespace NintendoExtensionCtrl {
+
+	void PortStats::reset() {
+		memset(this, 0, sizeof(PortStats));
+	}
+
+	void PortStats::recordUpdate(boolean success, boolean pointerSet, uint8_t nBytesRecv, uint8_t requestSize, unsigned long duration) {
+		if (success) {
+			updates++;
+		}
+		else if (nBytesRecv == requestSize) {
+			verifyErrors++;  // Got everything, but the data is bad
+		}
+		else if (nBytesRecv != 0) {
+			shortReads++;
+		}
+		else {
+			busErrors++;
+		}
+
+		if (pointerSet) {
+			bytesWritten += 1;  // Pointer, only if it was acknowledged
+		}
+		bytesRead += nBytesRecv;
+
+		uint16_t & count = updateTime[bucket(duration)];
+		if (count != 0xFFFF) {
+			count++;
+		}
+	}
+
+	void PortStats::recordReconnect() {
+		reconnects++;
+	}
+
+	void PortStats::recordCoalesced() {
+		coalesced++;
+	}
+
+	uint8_t PortStats::bucket(unsigned long us) {
+		uint8_t n = 0;
+		while (us > 1 && n < HistogramSize - 1) {
+			us >>= 1;
+			n++;
+		}
+		return n;
+	}
+
+	unsigned long PortStats::bucketMin(uint8_t n) {
+		return n == 0 ? 0 : 1UL << n;
+	}
+}
@@ -0,0 +1,58 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Stats_h
+#define NXC_Stats_h
+
+#include "Arduino.h"
+#include "NXC_Config.h"
+
+namespace NintendoExtensionCtrl {
+	// Running counters for a port, kept when NXC_ENABLE_STATS is set.
+	// Update times go into log2 buckets: bucket 0 is 0-1 us, and bucket n
+	// covers [2^n, 2^(n+1)) us, with the last bucket catching everything above.
+	struct PortStats {
+		uint32_t updates;       // Successful updates
+		uint32_t verifyErrors;  // Full reads rejected by verifyData()
+		uint32_t shortReads;    // Reads that came up short
+		uint32_t busErrors;     // Pointer write NACK'd, or nothing read
+		uint32_t reconnects;    // Successful (re)connections
+		uint32_t coalesced;     // Updates that reused a fresh frame, no bus traffic
+
+		uint32_t bytesWritten;  // Acknowledged pointer writes
+		uint32_t bytesRead;
+
+		static const uint8_t HistogramSize = 16;
+		uint16_t updateTime[HistogramSize];  // Saturates at 0xFFFF
+
+		void reset();
+
+		void recordUpdate(boolean success, boolean pointerSet, uint8_t nBytesRecv, uint8_t requestSize, unsigned long duration);
+		void recordReconnect();
+		void recordCoalesced();
+
+		static uint8_t bucket(unsigned long us);
+		static unsigned long bucketMin(uint8_t n);  // Lower bound of a bucket, in us
+	};
+}
+
+#endif
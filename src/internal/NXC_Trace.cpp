@@ -0,0 +1,86 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Trace.h"
+
+namespace NintendoExtensionCtrl {
+#if NXC_ENABLE_TRACE
+	namespace Trace {
+		static_assert((Size & (Size - 1)) == 0 && Size != 0, "NXC_TRACE_SIZE must be a power of two");
+
+		static TraceRecord buffer[Size];
+		static uint32_t head = 0;  // Total records written, the next index is 'head' masked
+		static const void * activePort = nullptr;  // Port whose update is running
+
+		void record(const void * port, const void * bus, TracePoint point, boolean begin) {
+			if (port == nullptr) {
+				port = activePort;  // Bus phase, inside the port's update
+			}
+			else if (point == TracePoint::Update) {
+				activePort = begin ? port : nullptr;
+			}
+
+			TraceRecord & r = buffer[head & (Size - 1)];
+			r.time = micros();
+			r.port = port;
+			r.bus = bus;
+			r.point = point;
+			r.begin = begin;
+			head++;
+		}
+
+		uint16_t available() {
+			return head < Size ? (uint16_t) head : Size;
+		}
+
+		uint32_t total() {
+			return head;
+		}
+
+		boolean get(uint16_t n, TraceRecord & out) {
+			const uint16_t count = available();
+			if (n >= count) {
+				return false;
+			}
+			out = buffer[(head - count + n) & (Size - 1)];
+			return true;
+		}
+
+		void clear() {
+			head = 0;  // 'activePort' stays, an update may be running
+		}
+	}
+#endif
+
+	const char * tracePointName(TracePoint point) {
+		switch (point) {
+			case(TracePoint::Update): return "update";
+			case(TracePoint::PointerWrite): return "pointerWrite";
+			case(TracePoint::ConversionWait): return "conversionWait";
+			case(TracePoint::RequestFrom): return "requestFrom";
+			case(TracePoint::ReadBytes): return "readBytes";
+			case(TracePoint::VerifyData): return "verifyData";
+			case(TracePoint::KnockoffFixup): return "knockoffFixup";
+			default: return "unknown";
+		}
+	}
+}
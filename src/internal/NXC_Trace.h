@@ -0,0 +1,84 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Trace_h
+#define NXC_Trace_h
+
+#include "Arduino.h"
+#include "NXC_Config.h"
+
+namespace NintendoExtensionCtrl {
+	enum class TracePoint : uint8_t {
+		Update,
+		PointerWrite,
+		ConversionWait,
+		RequestFrom,
+		ReadBytes,
+		VerifyData,
+		KnockoffFixup,
+		NumPoints,
+	};
+
+	// Fixed-size trace record. 'port' is the port's ExtensionData, which tells
+	// ports apart even when several share a bus (a mux, or several views).
+	// 'bus' is the I2C bus the phase ran on. Bus phases (pointer write through
+	// read) take the port of the update they're in, or nullptr outside one.
+	struct TraceRecord {
+		uint32_t time;  // micros()
+		const void * port;
+		const void * bus;
+		TracePoint point;
+		boolean begin;  // 'false' for the end of the phase
+	};
+
+#if NXC_ENABLE_TRACE
+	// Static ring buffer of the last NXC_TRACE_SIZE records. Recording is a
+	// micros() call, a store, and an increment. The buffer is not interrupt
+	// safe, so only trace from one context.
+	namespace Trace {
+		const uint16_t Size = NXC_TRACE_SIZE;
+
+		void record(const void * port, const void * bus, TracePoint point, boolean begin);  // nullptr port for the running update's
+
+		uint16_t available();  // Records in the buffer
+		uint32_t total();      // Records written since the last clear, including overwritten ones
+		boolean get(uint16_t n, TraceRecord & out);  // n = 0 is the oldest record
+		void clear();
+	}
+#endif
+
+	const char * tracePointName(TracePoint point);
+}
+
+#if NXC_ENABLE_TRACE
+#define NXC_TRACE_BEGIN(data, point) NintendoExtensionCtrl::Trace::record(&(data), (data).getBus(), NintendoExtensionCtrl::TracePoint::point, true)
+#define NXC_TRACE_END(data, point)   NintendoExtensionCtrl::Trace::record(&(data), (data).getBus(), NintendoExtensionCtrl::TracePoint::point, false)
+#define NXC_TRACE_BUS_BEGIN(bus, point) NintendoExtensionCtrl::Trace::record(nullptr, bus, NintendoExtensionCtrl::TracePoint::point, true)
+#define NXC_TRACE_BUS_END(bus, point)   NintendoExtensionCtrl::Trace::record(nullptr, bus, NintendoExtensionCtrl::TracePoint::point, false)
+#else
+#define NXC_TRACE_BEGIN(data, point)
+#define NXC_TRACE_END(data, point)
+#define NXC_TRACE_BUS_BEGIN(bus, point)
+#define NXC_TRACE_BUS_END(bus, point)
+#endif
+
+#endif
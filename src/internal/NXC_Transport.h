@@ -0,0 +1,63 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Transport_h
+#define NXC_Transport_h
+
+#include "Arduino.h"
+#include "NXC_Comms.h"
+
+namespace NintendoExtensionCtrl {
+	// Bus operations for a port, one function per complete transaction.
+	// 'TransportPolicy' below fills these in for a bus type, so the pointer
+	// write, conversion wait, and read are built and inlined for that bus.
+	// A port makes one indirect call per transaction, rather than one per
+	// Wire call, and ports on different bus types (the Wire library, a
+	// multiplexer, a bit-banged bus, a mock) can be used in one program.
+	struct Transport {
+		void (*begin)(void * bus);
+		boolean (*initialize)(void * bus);
+		boolean (*readData)(void * bus, uint8_t ptr, uint8_t size, uint8_t * dataOut, uint8_t & nBytesRecv, boolean & pointerSet);
+	};
+
+	template<class Bus>
+	struct TransportPolicy {
+		static void begin(void * bus) {
+			static_cast<Bus *>(bus)->begin();
+		}
+
+		static boolean initialize(void * bus) {
+			return NintendoExtensionCtrl::initialize(*static_cast<Bus *>(bus));
+		}
+
+		static boolean readData(void * bus, uint8_t ptr, uint8_t size, uint8_t * dataOut, uint8_t & nBytesRecv, boolean & pointerSet) {
+			return i2c_readDataArray(*static_cast<Bus *>(bus), I2C_Addr, ptr, size, dataOut, nBytesRecv, pointerSet);
+		}
+
+		static const Transport ops;
+	};
+
+	template<class Bus>
+	const Transport TransportPolicy<Bus>::ops = { &begin, &initialize, &readData };
+}
+
+#endif
@@ -94,6 +94,34 @@ namespace NintendoExtensionCtrl {
 		}
 	}
 
+	void printPadded(long value, uint8_t width, Print& output) {
+		// Same as "%*ld" without pulling in printf. Digits are built from the
+		// end of the buffer and written out in one call.
+		char buffer[12];  // Sign + 10 digits + slack
+		uint8_t pos = sizeof(buffer);
+
+		const boolean negative = value < 0;
+		unsigned long magnitude = negative ? 0UL - (unsigned long) value : (unsigned long) value;
+
+		do {
+			buffer[--pos] = '0' + (magnitude % 10);
+			magnitude /= 10;
+		} while (magnitude != 0);
+
+		if (negative) {
+			buffer[--pos] = '-';
+		}
+
+		if (width > sizeof(buffer)) {
+			width = sizeof(buffer);
+		}
+		while (sizeof(buffer) - pos < width) {
+			buffer[--pos] = ' ';
+		}
+
+		output.write((const uint8_t *) buffer + pos, sizeof(buffer) - pos);
+	}
+
 	RolloverChange::RolloverChange(uint8_t min, uint8_t max) :
 		minValue(min), maxValue(max) {}
 
@@ -129,5 +157,66 @@ namespace NintendoExtensionCtrl {
 	uint8_t RolloverChange::halfRange() const {
 		return ((maxValue - minValue) / 2) + 1;
 	}
-}
 
+	void ButtonDebounce::setDepth(uint8_t frames) {
+		depth = frames <= MaxDepth ? frames : MaxDepth;
+		reset();
+	}
+
+	uint8_t ButtonDebounce::getDepth() const {
+		return depth;
+	}
+
+	void ButtonDebounce::reset() {
+		count0 = count1 = count2 = 0;
+		seeded = false;
+	}
+
+	void ButtonDebounce::apply(uint8_t * controlData, ExtensionType type) {
+		if (depth == 0) {
+			return;  // Debouncing disabled
+		}
+
+		const uint16_t mask = buttonMask(type);
+		const uint16_t raw = (controlData[4] << 8) | controlData[5];
+
+		if (!seeded) {
+			state = raw;  // First frame after a (re)connect is taken as-is
+			seeded = true;
+			return;
+		}
+
+		// Count up on the bits that differ from the debounced state, and
+		// clear the counters for any bits that match it
+		const uint16_t delta = (raw ^ state) & mask;
+		count2 = (count2 ^ (count1 & count0)) & delta;
+		count1 = (count1 ^ count0) & delta;
+		count0 = ~count0 & delta;
+
+		// Flip the bits whose counters have reached the depth. Their counters
+		// will be cleared on the next frame, as they'll match the state.
+		uint16_t reached = delta;
+		reached &= (depth & 0x01) ? count0 : ~count0;
+		reached &= (depth & 0x02) ? count1 : ~count1;
+		reached &= (depth & 0x04) ? count2 : ~count2;
+		state ^= reached;
+
+		const uint16_t dataOut = (raw & ~mask) | (state & mask);  // Non-button bits untouched
+		controlData[4] = dataOut >> 8;
+		controlData[5] = dataOut & 0xFF;
+	}
+
+	uint16_t ButtonDebounce::buttonMask(ExtensionType type) {
+		switch (type) {
+			case(ExtensionType::Nunchuk):
+				return 0x0003;  // C and Z, the rest of byte 5 is accelerometer data
+			case(ExtensionType::ClassicController):  // Intentionally fall through cases
+			case(ExtensionType::GuitarController):
+			case(ExtensionType::DrumController):
+			case(ExtensionType::DJTurntableController):
+				return 0xFEFF;  // Everything but byte 4 bit 0, the DJ turntable sign
+			default:
+				return 0x0000;  // Unknown layout, leave it alone
+		}
+	}
+}
@@ -32,6 +32,7 @@ namespace NintendoExtensionCtrl {
 	void printRaw(const uint8_t * dataIn, uint8_t dataSize, uint8_t baseFormat = HEX, Print& output = NXC_SERIAL_DEFAULT);
 	void printRaw(uint8_t dataIn, uint8_t baseFormat = HEX, Print& output = NXC_SERIAL_DEFAULT);
 	void printRepeat(char c, uint8_t nPrint, Print& output = NXC_SERIAL_DEFAULT);
+	void printPadded(long value, uint8_t width, Print& output = NXC_SERIAL_DEFAULT);  // Decimal, right-aligned with spaces
 
 	class RolloverChange {
 	public:
@@ -46,6 +47,33 @@ namespace NintendoExtensionCtrl {
 
 		uint8_t lastValue = 0;
 	};
+
+	// Vertical counter debounce for the button bytes (4 and 5). Every bit has
+	// its own 3-bit counter spread across three words, so all 16 buttons are
+	// filtered at once with a handful of bitwise operations per frame. It runs
+	// after the port's frame fixup, so an NES knockoff's buttons, moved there
+	// from bytes 6 and 7, are debounced like any other controller's.
+	class ButtonDebounce {
+	public:
+		void setDepth(uint8_t frames);  // Frames a change must hold for, 0 (off) to 7
+		uint8_t getDepth() const;
+
+		void reset();
+		void apply(uint8_t * controlData, ExtensionType type);
+
+		static const uint8_t MaxDepth = 7;
+
+	private:
+		static uint16_t buttonMask(ExtensionType type);
+
+		uint16_t state = 0xFFFF;  // Debounced button bits, '1' is released
+		uint16_t count0 = 0;  // Counter bit planes, per button
+		uint16_t count1 = 0;
+		uint16_t count2 = 0;
+
+		uint8_t depth = 0;
+		boolean seeded = false;  // Whether 'state' has been set from live data
+	};
 }
 
 #endif
@@ -0,0 +1,90 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Capture.h"
+
+namespace NintendoExtensionCtrl {
+	namespace Capture {
+		static const uint8_t Magic[4] = { 'N', 'X', 'C', 'R' };
+
+		void makeHeader(Header & header, ExtensionType type, const uint8_t * id, uint8_t requestSize) {
+			memset(&header, 0x00, sizeof(Header));
+			memcpy(header.magic, Magic, sizeof(Magic));
+			header.version = Version;
+			header.type = (uint8_t) type;
+			memcpy(header.id, id, ID_Size);
+			header.requestSize = requestSize;
+			header.stride = TimestampSize + requestSize;
+		}
+
+		boolean validHeader(const Header & header) {
+			return memcmp(header.magic, Magic, sizeof(Magic)) == 0
+				&& header.version == Version
+				&& header.requestSize != 0
+				&& header.stride == TimestampSize + header.requestSize;
+		}
+
+		uint32_t recordTime(const uint8_t * record) {
+			return (uint32_t) record[0] | ((uint32_t) record[1] << 8)
+				| ((uint32_t) record[2] << 16) | ((uint32_t) record[3] << 24);
+		}
+	}
+
+	boolean CaptureWriter::begin(ExtensionType t, const uint8_t * id, uint8_t size) {
+		if (size == 0 || size > Capture::MaxRequestSize) {
+			return false;
+		}
+
+		Capture::Header header;
+		Capture::makeHeader(header, t, id, size);
+		if (out.write((const uint8_t *) &header, sizeof(header)) != sizeof(header)) {
+			return false;
+		}
+
+		type = t;
+		requestSize = size;
+		startTime = micros();
+		records = 0;
+		return true;
+	}
+
+	boolean CaptureWriter::record(const uint8_t * controlData, uint32_t timestamp) {
+		if (requestSize == 0) {
+			return false;  // No header written
+		}
+
+		uint8_t buffer[Capture::TimestampSize + Capture::MaxRequestSize];
+		const uint32_t t = timestamp - startTime;
+		buffer[0] = (uint8_t) t;
+		buffer[1] = (uint8_t) (t >> 8);
+		buffer[2] = (uint8_t) (t >> 16);
+		buffer[3] = (uint8_t) (t >> 24);
+		memcpy(buffer + Capture::TimestampSize, controlData, requestSize);
+
+		const size_t stride = Capture::TimestampSize + requestSize;
+		if (out.write(buffer, stride) != stride) {
+			return false;
+		}
+		records++;
+		return true;
+	}
+}
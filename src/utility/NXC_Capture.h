@@ -0,0 +1,116 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Capture_h
+#define NXC_Capture_h
+
+#include "Arduino.h"
+#include "internal/NXC_Config.h"
+#include "internal/NXC_Identity.h"
+#include "internal/NXC_Comms.h"
+
+namespace NintendoExtensionCtrl {
+	// Capture format for recorded sessions. A 16 byte header, followed by
+	// fixed-stride records. All values are little endian.
+	//
+	// Header:
+	//   [0-3]    Magic, "NXCR"
+	//   [4]      Format version
+	//   [5]      ExtensionType
+	//   [6-11]   Raw controller ID, as read from 0xFA
+	//   [12]     Request size (control data bytes per record)
+	//   [13]     Stride (bytes per record, timestamp + request size)
+	//   [14-15]  Reserved, zero
+	//
+	// Record:
+	//   [0-3]    Timestamp in microseconds, from the start of the capture
+	//   [4-...]  Control data, 'request size' bytes
+	namespace Capture {
+		const uint8_t Version = 1;
+		const uint8_t HeaderSize = 16;
+		const uint8_t TimestampSize = 4;
+		const uint8_t MaxRequestSize = 21;
+
+		struct Header {
+			uint8_t magic[4];
+			uint8_t version;
+			uint8_t type;
+			uint8_t id[ID_Size];
+			uint8_t requestSize;
+			uint8_t stride;
+			uint8_t reserved[2];
+		};
+
+		void makeHeader(Header & header, ExtensionType type, const uint8_t * id, uint8_t requestSize);
+		boolean validHeader(const Header & header);
+
+		uint32_t recordTime(const uint8_t * record);
+		inline const uint8_t * recordData(const uint8_t * record) { return record + TimestampSize; }
+	}
+
+	// Writes a capture to any Print, such as an SD card file. 'begin()' reads
+	// the controller's ID and writes the header, then 'record()' appends the
+	// current control data after each update. If the controller's type or
+	// request size changes, 'record()' fails and a new capture needs to begin.
+	class CaptureWriter {
+	public:
+		CaptureWriter(Print & output) : out(output) {}
+
+		template<class Controller>
+		boolean begin(Controller & controller) {
+			uint8_t id[ID_Size];
+			if (!controller.readIdentity(id)) {
+				return false;
+			}
+			return begin(controller.getControllerType(), id, controller.getRequestSize());
+		}
+		boolean begin(ExtensionType type, const uint8_t * id, uint8_t requestSize);
+
+		template<class Controller>
+		boolean record(const Controller & controller) {
+			if (controller.getControllerType() != type || controller.getRequestSize() != requestSize) {
+				return false;
+			}
+			uint8_t data[Capture::MaxRequestSize];
+		#if NXC_ENABLE_ISR_SAFE
+			controller.readFrame(data, requestSize);  // All bytes from one frame
+		#else
+			for (uint8_t i = 0; i < requestSize; i++) {
+				data[i] = controller.getControlData(i);
+			}
+		#endif
+			return record(data, micros());
+		}
+		boolean record(const uint8_t * controlData, uint32_t timestamp);  // 'timestamp' from micros()
+
+		uint32_t recordsWritten() const { return records; }
+
+	private:
+		Print & out;
+		ExtensionType type = ExtensionType::NoController;
+		uint8_t requestSize = 0;  // 0 until 'begin()'
+		uint32_t startTime = 0;
+		uint32_t records = 0;
+	};
+}
+
+#endif
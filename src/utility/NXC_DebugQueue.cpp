@@ -0,0 +1,91 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_DebugQueue.h"
+
+namespace NintendoExtensionCtrl {
+	size_t DebugQueue::write(uint8_t c) {
+		if (discarding) {
+			if (c == '\n') {
+				discarding = false;  // Next line starts fresh
+			}
+		}
+		else if (committed + pending == capacity) {
+			pending = 0;  // No room, drop the line
+			discarding = (c != '\n');
+			if (dropped != 0xFFFF) {
+				dropped++;
+			}
+		}
+		else {
+			size_t index = head + committed + pending;
+			if (index >= capacity) {
+				index -= capacity;
+			}
+			queue[index] = c;
+			pending++;
+
+			if (c == '\n') {
+				committed += pending;
+				pending = 0;
+			}
+		}
+		return 1;  // Always 'written', the caller never waits
+	}
+
+	size_t DebugQueue::write(const uint8_t * data, size_t size) {
+		for (size_t i = 0; i < size; i++) {
+			write(data[i]);
+		}
+		return size;
+	}
+
+	size_t DebugQueue::drain(Print & output, size_t maxBytes) {
+		size_t sent = 0;
+
+		while (committed != 0 && sent < maxBytes) {
+			// Contiguous run from the head, up to the end of the buffer
+			size_t run = capacity - head;
+			if (run > committed) run = committed;
+			if (run > maxBytes - sent) run = maxBytes - sent;
+
+			const size_t written = output.write(queue + head, run);
+
+			head += written;
+			if (head >= capacity) {
+				head -= capacity;
+			}
+			committed -= written;
+			sent += written;
+
+			if (written != run) break;  // Output is full
+		}
+		return sent;
+	}
+
+	void DebugQueue::clear() {
+		head = 0;
+		committed = 0;
+		pending = 0;
+		discarding = false;
+	}
+}
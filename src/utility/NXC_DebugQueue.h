@@ -0,0 +1,85 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_DebugQueue_h
+#define NXC_DebugQueue_h
+
+#include "Arduino.h"
+
+namespace NintendoExtensionCtrl {
+	// Non-blocking output queue for debug text. Print to it as you would to
+	// Serial, then call 'drain()' from the loop to pass along only as much as
+	// the output can take without blocking. Lines are queued whole: a line
+	// only becomes visible to 'drain()' once its newline is written, and if a
+	// line doesn't fit it's dropped (and counted) rather than stalling or
+	// leaving half a line in the output. Storage is provided by
+	// 'DebugQueueBuffer' below.
+	class DebugQueue : public Print {
+	public:
+		size_t write(uint8_t c) override;
+		size_t write(const uint8_t * data, size_t size) override;
+		using Print::write;
+
+		// Up to output.availableForWrite() bytes. A template so it only needs
+		// availableForWrite() on the output's own class, and only if it's used:
+		// some cores don't declare it on Print.
+		template<class Output>
+		size_t drain(Output & output) {
+			const int space = output.availableForWrite();
+			return space > 0 ? drain(output, (size_t) space) : 0;
+		}
+
+		size_t drain(Print & output, size_t maxBytes);  // For outputs without availableForWrite()
+
+		size_t available() const { return committed; }  // Bytes of whole lines waiting
+		void clear();
+
+		uint16_t linesDropped() const { return dropped; }
+		void resetDropped() { dropped = 0; }
+
+	protected:
+		DebugQueue(uint8_t * buffer, size_t bufferSize) :
+			queue(buffer), capacity(bufferSize) {}
+
+	private:
+		uint8_t * const queue;
+		const size_t capacity;
+
+		size_t head = 0;       // Index of the oldest committed byte
+		size_t committed = 0;  // Bytes of complete lines
+		size_t pending = 0;    // Bytes of the line being written
+		boolean discarding = false;  // Current line didn't fit, skip to its newline
+
+		uint16_t dropped = 0;  // Saturates at 0xFFFF
+	};
+
+	template<size_t Size>
+	class DebugQueueBuffer : public DebugQueue {
+	public:
+		DebugQueueBuffer() : DebugQueue(buffer, Size) {}
+
+	private:
+		uint8_t buffer[Size];
+	};
+}
+
+#endif
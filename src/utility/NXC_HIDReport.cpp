@@ -0,0 +1,195 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_HIDReport.h"
+
+#include "controllers/Nunchuk.h"
+#include "controllers/ClassicController.h"
+#include "controllers/GuitarController.h"
+#include "controllers/DrumController.h"
+#include "controllers/DJTurntable.h"
+
+namespace NintendoExtensionCtrl {
+	const uint8_t HIDGamepadDescriptor[] PROGMEM = {
+		0x05, 0x01,        // Usage Page (Generic Desktop)
+		0x09, 0x05,        // Usage (Game Pad)
+		0xA1, 0x01,        // Collection (Application)
+		0x05, 0x09,        //   Usage Page (Button)
+		0x19, 0x01,        //   Usage Minimum (1)
+		0x29, 0x10,        //   Usage Maximum (16)
+		0x15, 0x00,        //   Logical Minimum (0)
+		0x25, 0x01,        //   Logical Maximum (1)
+		0x75, 0x01,        //   Report Size (1)
+		0x95, 0x10,        //   Report Count (16)
+		0x81, 0x02,        //   Input (Data, Variable, Absolute)
+		0x05, 0x01,        //   Usage Page (Generic Desktop)
+		0x09, 0x30,        //   Usage (X)
+		0x09, 0x31,        //   Usage (Y)
+		0x09, 0x33,        //   Usage (Rx)
+		0x09, 0x34,        //   Usage (Ry)
+		0x09, 0x32,        //   Usage (Z)
+		0x09, 0x35,        //   Usage (Rz)
+		0x15, 0x00,        //   Logical Minimum (0)
+		0x26, 0xFF, 0x00,  //   Logical Maximum (255)
+		0x75, 0x08,        //   Report Size (8)
+		0x95, 0x06,        //   Report Count (6)
+		0x81, 0x02,        //   Input (Data, Variable, Absolute)
+		0xC0,              // End Collection
+	};
+
+	const uint16_t HIDGamepadDescriptorSize = sizeof(HIDGamepadDescriptor);
+
+	namespace {
+		// Part of an axis value: control data byte, mask, then shifts right and left
+		struct HIDAxisPart {
+			uint8_t index;
+			uint8_t mask;
+			uint8_t right;
+			uint8_t left;
+		};
+
+		constexpr HIDAxisPart part(ByteMap map) {
+			return { map.index, map.mask, map.offset, 0 };
+		}
+
+		constexpr HIDAxisPart part(CtrlIndex index) {
+			return { index, 0xFF, 0, 0 };
+		}
+
+		constexpr HIDAxisPart signPart(ByteMap map) {
+			return { map.index, map.mask, map.offset, 5 };  // Moved up to bit 5
+		}
+
+		// An axis: up to four parts OR'd together (unused parts have no mask),
+		// the width of the result, and bits to flip (sign bits to offset binary,
+		// or every bit to invert)
+		struct HIDAxis {
+			HIDAxisPart parts[4];
+			uint8_t bits;  // 0 if the controller doesn't have this axis
+			uint8_t flip;
+		};
+
+		constexpr HIDAxis NoAxis = { {}, 0, 0x00 };
+
+		struct HIDLayout {
+			HIDAxis axes[HIDReportBuilder::NumAxes];
+		};
+
+		typedef Nunchuk_Shared::Maps NunchukMaps;
+		typedef ClassicController_Shared::Maps ClassicMaps;
+		typedef GuitarController_Shared::Maps GuitarMaps;
+		typedef DrumController_Shared::Maps DrumMaps;
+		typedef DJTurntableController_Shared::Maps DJMaps;
+
+		// Axis layouts in flash, indexed by ExtensionType from 'FirstLayout' on.
+		// Buttons come from the ButtonRemap tables instead.
+		const ExtensionType FirstLayout = ExtensionType::Nunchuk;
+
+		constexpr HIDLayout Layouts[] PROGMEM = {
+			{ {  // Nunchuk
+				{ { part(NunchukMaps::JoyX) }, 8, 0x00 },
+				{ { part(NunchukMaps::JoyY) }, 8, 0xFF },
+				{ { part(NunchukMaps::AccelX_MSB) }, 8, 0x00 },
+				{ { part(NunchukMaps::AccelY_MSB) }, 8, 0x00 },
+				NoAxis,
+				{ { part(NunchukMaps::AccelZ_MSB) }, 8, 0x00 },
+			} },
+			{ {  // ClassicController
+				{ { part(ClassicMaps::LeftJoyX) }, 6, 0x00 },
+				{ { part(ClassicMaps::LeftJoyY) }, 6, 0x3F },
+				{ { part(ClassicMaps::RightJoyX[0]), part(ClassicMaps::RightJoyX[1]), part(ClassicMaps::RightJoyX[2]) }, 5, 0x00 },
+				{ { part(ClassicMaps::RightJoyY) }, 5, 0x1F },
+				{ { part(ClassicMaps::TriggerL[0]), part(ClassicMaps::TriggerL[1]) }, 5, 0x00 },
+				{ { part(ClassicMaps::TriggerR) }, 5, 0x00 },
+			} },
+			{ {  // GuitarController
+				{ { part(GuitarMaps::JoyX) }, 6, 0x00 },
+				{ { part(GuitarMaps::JoyY) }, 6, 0x3F },
+				NoAxis,
+				NoAxis,
+				{ { part(GuitarMaps::Whammy) }, 5, 0x00 },
+				{ { part(GuitarMaps::Touchbar) }, 5, 0x00 },
+			} },
+			{ {  // DrumController
+				{ { part(DrumMaps::JoyX) }, 6, 0x00 },
+				{ { part(DrumMaps::JoyY) }, 6, 0x3F },
+				NoAxis,
+				NoAxis,
+				NoAxis,
+				NoAxis,
+			} },
+			{ {  // DJTurntableController
+				{ { part(DJMaps::JoyX) }, 6, 0x00 },
+				{ { part(DJMaps::JoyY) }, 6, 0x3F },
+				// Turntables are 5 bits and a sign bit, flipped to offset binary
+				{ { part(DJMaps::Left_Turntable), signPart(DJMaps::Left_TurntableSign) }, 6, 0x20 },
+				{ { part(DJMaps::Right_Turntable[0]), part(DJMaps::Right_Turntable[1]), part(DJMaps::Right_Turntable[2]), signPart(DJMaps::Right_TurntableSign) }, 6, 0x20 },
+				{ { part(DJMaps::CrossfadeSlider) }, 4, 0x00 },
+				{ { part(DJMaps::EffectDial[0]), part(DJMaps::EffectDial[1]) }, 5, 0x00 },
+			} },
+		};
+
+		const uint8_t NumLayouts = sizeof(Layouts) / sizeof(HIDLayout);
+		static_assert((uint8_t) ExtensionType::DJTurntableController - (uint8_t) FirstLayout == NumLayouts - 1,
+			"HID layouts must follow the ExtensionType order");
+
+		// Widens a value to 8 bits by repeating its top bits. 4 bits or more.
+		inline uint8_t expand(uint8_t value, uint8_t bits) {
+			return (value << (8 - bits)) | (value >> (2 * bits - 8));
+		}
+	}
+
+	HIDReportBuilder::HIDReportBuilder(ButtonRemap & buttonMap) : remap(buttonMap) {}
+
+	boolean HIDReportBuilder::build(ExtensionType type, const uint8_t * controlData) {
+		uint8_t next[ReportSize] = { 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 };
+
+		if (remap.getType() != type) {
+			remap.compile(type);  // Connected type changed
+		}
+		const uint16_t buttons = remap.map(controlData[4], controlData[5]);
+		next[0] = buttons & 0xFF;
+		next[1] = buttons >> 8;
+
+		const uint8_t layout = (uint8_t) type - (uint8_t) FirstLayout;  // Wraps around for types below
+		if (layout < NumLayouts) {
+			const HIDAxis * axis = Layouts[layout].axes;
+			for (uint8_t a = 0; a < NumAxes; a++, axis++) {
+				const uint8_t bits = pgm_read_byte(&axis->bits);
+				if (bits == 0) continue;
+
+				uint8_t value = 0;
+				for (const HIDAxisPart & p : axis->parts) {
+					const uint8_t mask = pgm_read_byte(&p.mask);
+					if (mask == 0) break;
+					value |= ((controlData[pgm_read_byte(&p.index)] & mask) >> pgm_read_byte(&p.right)) << pgm_read_byte(&p.left);
+				}
+				next[2 + a] = expand(value ^ pgm_read_byte(&axis->flip), bits);
+			}
+		}
+
+		const boolean changed = !valid || memcmp(next, report, ReportSize) != 0;
+		memcpy(report, next, ReportSize);
+		valid = true;
+		return changed;
+	}
+}
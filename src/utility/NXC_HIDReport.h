@@ -0,0 +1,93 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_HIDReport_h
+#define NXC_HIDReport_h
+
+#include "Arduino.h"
+#include "internal/NXC_Config.h"
+#include "internal/NXC_Identity.h"
+#include "NXC_Remap.h"
+
+namespace NintendoExtensionCtrl {
+	// Builds USB HID gamepad reports straight from control data. The report
+	// is 8 bytes, laid out by 'HIDGamepadDescriptor':
+	//
+	//   Bytes 0-1   16 buttons, little endian, in VirtualGamepad bit order
+	//   Bytes 2-7   X, Y, Rx, Ry, Z, Rz axes, 0-255 with 128 at rest
+	//
+	// Buttons come from a ButtonRemap, so the report follows whatever profile
+	// it was given, and cost two table lookups. The remap can be shared with
+	// the rest of the sketch. Each controller type has a table in flash of
+	// where its axes sit in the control data, so an axis is a few masks and
+	// shifts instead of an accessor call. Axes are widened to 8 bits by
+	// repeating their top bits, so full scale reads 255. Y axes are flipped
+	// to HID's "up is the minimum". Axes a controller doesn't have rest at 128.
+	//
+	//   Nunchuk       X, Y: joystick. Rx, Ry, Rz: top 8 bits of the accelerometer
+	//   Classic       X, Y: left stick. Rx, Ry: right stick. Z, Rz: L and R triggers
+	//   Guitar        X, Y: joystick. Z: whammy bar. Rz: touchbar
+	//   Drums         X, Y: joystick
+	//   DJ Turntable  X, Y: joystick. Rx, Ry: left and right tables. Z: crossfader. Rz: effect dial
+	//
+	// NES knockoffs need fixNESKnockoffData() first, like any other reader.
+	class HIDReportBuilder {
+	public:
+		static const uint8_t ReportSize = 8;
+		static const uint8_t NumAxes = 6;
+
+		HIDReportBuilder(ButtonRemap & buttonMap);
+
+		template<class Controller>
+		boolean build(const Controller & controller) {
+			uint8_t data[DataSize];
+		#if NXC_ENABLE_ISR_SAFE
+			controller.readFrame(data, DataSize);  // All bytes from one frame
+		#else
+			for (uint8_t i = 0; i < DataSize; i++) {
+				data[i] = controller.getControlData(i);
+			}
+		#endif
+			return build(controller.getControllerType(), data);
+		}
+
+		boolean build(ExtensionType type, const uint8_t * controlData);  // 'true' if the report changed
+
+		const uint8_t * getReport() const { return report; }
+		uint16_t getButtons() const { return report[0] | (report[1] << 8); }
+		uint8_t getAxis(uint8_t axis) const { return report[2 + axis]; }
+
+		void invalidate() { valid = false; }  // Next build reports a change, e.g. after a USB reset
+
+		static const uint8_t DataSize = 6;  // Control data bytes the tables read
+
+	private:
+		ButtonRemap & remap;  // Button tables, recompiled when the type changes
+		uint8_t report[ReportSize] = { 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 };
+		boolean valid = false;  // Whether 'report' has been sent before
+	};
+
+	extern const uint8_t HIDGamepadDescriptor[] PROGMEM;
+	extern const uint16_t HIDGamepadDescriptorSize;
+}
+
+#endif
@@ -0,0 +1,233 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_MultiController_h
+#define NXC_MultiController_h
+
+#include "Arduino.h"
+#include "internal/ExtensionController.h"
+#include "controllers/Nunchuk.h"
+#include "controllers/ClassicController.h"
+#include "controllers/GuitarController.h"
+#include "controllers/DrumController.h"
+#include "controllers/DJTurntable.h"
+
+namespace NintendoExtensionCtrl {
+	// What MultiController needs to know about a controller class: the type
+	// it reads, the request size to use once it's connected, and a fixup to
+	// run on every new frame. Specialize this for your own controller classes.
+	template<class Shared>
+	struct ControllerTraits;
+
+	template<class Shared, ExtensionType T>
+	struct DefaultTraits {
+		static constexpr ExtensionType Type = T;
+		static constexpr uint8_t RequestSize = ExtensionController::MinRequestSize;
+		static constexpr boolean HasFixup = false;
+		static void fixup(Shared &) {}
+	};
+
+	template<> struct ControllerTraits<Nunchuk_Shared> :
+		DefaultTraits<Nunchuk_Shared, ExtensionType::Nunchuk> {};
+	template<> struct ControllerTraits<ClassicController_Shared> :
+		DefaultTraits<ClassicController_Shared, ExtensionType::ClassicController> {};
+	template<> struct ControllerTraits<SNESMiniController_Shared> :
+		DefaultTraits<SNESMiniController_Shared, ExtensionType::ClassicController> {};
+	template<> struct ControllerTraits<GuitarController_Shared> :
+		DefaultTraits<GuitarController_Shared, ExtensionType::GuitarController> {};
+	template<> struct ControllerTraits<DrumController_Shared> :
+		DefaultTraits<DrumController_Shared, ExtensionType::DrumController> {};
+	template<> struct ControllerTraits<DJTurntableController_Shared> :
+		DefaultTraits<DJTurntableController_Shared, ExtensionType::DJTurntableController> {};
+
+	// NES Minis read 8 bytes, so the knockoff fixup has the button bytes it needs
+	template<> struct ControllerTraits<NESMiniController_Shared> :
+		DefaultTraits<NESMiniController_Shared, ExtensionType::ClassicController> {
+		static constexpr uint8_t RequestSize = 8;
+		static constexpr boolean HasFixup = true;
+		static void fixup(NESMiniController_Shared & nes) { nes.fixKnockoffData(); }
+	};
+
+	// One row of MultiController's decoder table
+	struct MultiDecoder {
+		typedef void (*Fixup)(ExtensionController::ExtensionData &);
+
+		uint8_t slot;         // Position in the controller list, 'NoSlot' if not listed
+		uint8_t requestSize;
+		Fixup fixup;          // nullptr for none
+
+		static const uint8_t NoSlot = 0xFF;
+	};
+
+	template<class Shared>
+	void runFixup(ExtensionController::ExtensionData & data) {
+		Shared view(data);
+		ControllerTraits<Shared>::fixup(view);
+	}
+
+	// Decoder for 'type': the first controller in the list that reads it
+	template<class... Controllers>
+	struct MultiDecoderFor {
+		static constexpr MultiDecoder get(ExtensionType, uint8_t) {
+			return { MultiDecoder::NoSlot, ExtensionController::MinRequestSize, nullptr };
+		}
+	};
+
+	template<class Controller, class... Rest>
+	struct MultiDecoderFor<Controller, Rest...> {
+		typedef typename Controller::Shared Shared;
+		typedef ControllerTraits<Shared> Traits;
+
+		static constexpr MultiDecoder get(ExtensionType type, uint8_t slot) {
+			return Traits::Type == type ?
+				MultiDecoder{ slot, Traits::RequestSize, Traits::HasFixup ? &runFixup<Shared> : nullptr } :
+				MultiDecoderFor<Rest...>::get(type, slot + 1);
+		}
+	};
+
+	// One port that reads any of several controller types, e.g.
+	//
+	//   NintendoExtensionCtrl::MultiController<Nunchuk, ClassicController, GuitarController> port;
+	//
+	// There is one data instance and no per-type objects. On connect() the
+	// connected type is looked up in a table built at compile time, indexed
+	// by ExtensionType, which gives that type's request size, fixup, and its
+	// position in the list. update() then runs the fixup, if any, with no
+	// checks on the type. visit() calls a visitor with a view of the data as
+	// the connected controller's 'Shared' class:
+	//
+	//   struct PrintDebug {
+	//       template<class Controller> void operator()(Controller & c) const { c.printDebug(); }
+	//   };
+	//   port.visit(PrintDebug());
+	//
+	// The visitor needs an operator() for every class in the list. The view
+	// is built on the stack for each call, so anything a class keeps between
+	// calls (like the DJ turntable config) is worked out again each time.
+	// Controllers that aren't in the list don't connect. The fixups only run
+	// from this class's update(), not through an ExtensionController reference.
+	template<class... Controllers>
+	class MultiController : public ExtensionController {
+	public:
+		static_assert(sizeof...(Controllers) > 0, "MultiController needs at least one controller class");
+		static_assert(sizeof...(Controllers) < MultiDecoder::NoSlot, "Too many controller classes");
+
+		MultiController(NXC_I2C_TYPE & i2cBus = NXC_I2C_DEFAULT) :
+			ExtensionController(portData),
+			portData(i2cBus) {}
+
+		boolean connect() {
+			return select(ExtensionController::connect());
+		}
+
+		boolean reconnect() {
+			return select(ExtensionController::reconnect());
+		}
+
+		boolean update() {
+			if (active == nullptr || !ExtensionController::update()) {
+				return false;
+			}
+			if (active->fixup != nullptr) {
+				active->fixup(portData);
+			}
+			return true;
+		}
+
+		// Position of the connected controller's class in the list, -1 for none
+		int8_t getSlot() const {
+			return active != nullptr ? (int8_t) active->slot : -1;
+		}
+
+		template<class Visitor>
+		boolean visit(Visitor & visitor) {
+			return dispatch<Visitor>(visitor);
+		}
+
+		template<class Visitor>
+		boolean visit(const Visitor & visitor) {
+			return dispatch<const Visitor>(visitor);
+		}
+
+	protected:
+		ExtensionController::ExtensionData portData;
+
+	private:
+		typedef ExtensionController::ExtensionData Data;
+
+		static constexpr uint8_t NumTypes = (uint8_t) ExtensionType::DJTurntableController + 1;
+		static const MultiDecoder Decoders[NumTypes];
+
+		const MultiDecoder * active = nullptr;  // Decoder for the connected type
+
+		boolean select(boolean connected) {
+			const uint8_t type = (uint8_t) getControllerType();
+			active = nullptr;
+
+			if (!connected || type >= NumTypes || Decoders[type].slot == MultiDecoder::NoSlot) {
+				return false;  // Nothing connected, or not a type we read
+			}
+			active = &Decoders[type];
+
+			if (getRequestSize() != active->requestSize) {
+				setRequestSize(active->requestSize);
+				return update();  // Seed again at the new size
+			}
+			if (active->fixup != nullptr) {
+				active->fixup(portData);
+			}
+			return true;
+		}
+
+		template<class Shared, class Visitor>
+		static void visitAs(Data & data, uint8_t requestSize, Visitor & visitor) {
+			Shared view(data);
+			view.setRequestSize(requestSize);  // For the raw debug output
+			visitor(view);
+		}
+
+		template<class Visitor>
+		boolean dispatch(Visitor & visitor) {
+			if (active == nullptr) return false;
+
+			typedef void (*Call)(Data &, uint8_t, Visitor &);
+			static const Call calls[] = { &visitAs<typename Controllers::Shared, Visitor>... };
+
+			calls[active->slot](portData, getRequestSize(), visitor);
+			return true;
+		}
+	};
+
+	template<class... Controllers>
+	const MultiDecoder MultiController<Controllers...>::Decoders[MultiController<Controllers...>::NumTypes] = {
+		MultiDecoderFor<Controllers...>::get(ExtensionType::NoController, 0),
+		MultiDecoderFor<Controllers...>::get(ExtensionType::AnyController, 0),
+		MultiDecoderFor<Controllers...>::get(ExtensionType::UnknownController, 0),
+		MultiDecoderFor<Controllers...>::get(ExtensionType::Nunchuk, 0),
+		MultiDecoderFor<Controllers...>::get(ExtensionType::ClassicController, 0),
+		MultiDecoderFor<Controllers...>::get(ExtensionType::GuitarController, 0),
+		MultiDecoderFor<Controllers...>::get(ExtensionType::DrumController, 0),
+		MultiDecoderFor<Controllers...>::get(ExtensionType::DJTurntableController, 0),
+	};
+}
+
+#endif
@@ -0,0 +1,131 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Remap.h"
+
+#include "controllers/Nunchuk.h"
+#include "controllers/ClassicController.h"
+#include "controllers/GuitarController.h"
+#include "controllers/DrumController.h"
+#include "controllers/DJTurntable.h"
+
+namespace NintendoExtensionCtrl {
+
+	using Gamepad = VirtualGamepad;
+
+	const RemapEntry DefaultRemapProfile[] = {
+		// Nunchuk
+		{ ExtensionType::Nunchuk, Nunchuk_Shared::Maps::ButtonC, Gamepad::A },
+		{ ExtensionType::Nunchuk, Nunchuk_Shared::Maps::ButtonZ, Gamepad::B },
+
+		// Classic Controller, NES Mini, and SNES Mini
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonA, Gamepad::A },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonB, Gamepad::B },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonX, Gamepad::X },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonY, Gamepad::Y },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonL, Gamepad::L },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonR, Gamepad::R },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonZL, Gamepad::ZL },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonZR, Gamepad::ZR },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonPlus, Gamepad::Start },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonMinus, Gamepad::Select },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::ButtonHome, Gamepad::Home },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::DpadUp, Gamepad::DpadUp },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::DpadDown, Gamepad::DpadDown },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::DpadLeft, Gamepad::DpadLeft },
+		{ ExtensionType::ClassicController, ClassicController_Shared::Maps::DpadRight, Gamepad::DpadRight },
+
+		// Guitar, frets in face button order and the strum bar on the D-pad
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::FretGreen, Gamepad::A },
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::FretRed, Gamepad::B },
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::FretYellow, Gamepad::Y },
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::FretBlue, Gamepad::X },
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::FretOrange, Gamepad::L },
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::StrumUp, Gamepad::DpadUp },
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::StrumDown, Gamepad::DpadDown },
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::ButtonPlus, Gamepad::Start },
+		{ ExtensionType::GuitarController, GuitarController_Shared::Maps::ButtonMinus, Gamepad::Select },
+
+		// Drums, pads in face button order and the pedal on the shoulder
+		{ ExtensionType::DrumController, DrumController_Shared::Maps::DrumGreen, Gamepad::A },
+		{ ExtensionType::DrumController, DrumController_Shared::Maps::DrumRed, Gamepad::B },
+		{ ExtensionType::DrumController, DrumController_Shared::Maps::CymbalYellow, Gamepad::Y },
+		{ ExtensionType::DrumController, DrumController_Shared::Maps::DrumBlue, Gamepad::X },
+		{ ExtensionType::DrumController, DrumController_Shared::Maps::CymbalOrange, Gamepad::R },
+		{ ExtensionType::DrumController, DrumController_Shared::Maps::Pedal, Gamepad::L },
+		{ ExtensionType::DrumController, DrumController_Shared::Maps::ButtonPlus, Gamepad::Start },
+		{ ExtensionType::DrumController, DrumController_Shared::Maps::ButtonMinus, Gamepad::Select },
+
+		// DJ Turntable, both tables share the face buttons
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::Left_ButtonGreen, Gamepad::A },
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::Left_ButtonRed, Gamepad::B },
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::Left_ButtonBlue, Gamepad::X },
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::Right_ButtonGreen, Gamepad::A },
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::Right_ButtonRed, Gamepad::B },
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::Right_ButtonBlue, Gamepad::X },
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::ButtonEuphoria, Gamepad::Y },
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::ButtonPlus, Gamepad::Start },
+		{ ExtensionType::DJTurntableController, DJTurntableController_Shared::Maps::ButtonMinus, Gamepad::Select },
+	};
+
+	const size_t DefaultRemapProfileSize = sizeof(DefaultRemapProfile) / sizeof(RemapEntry);
+
+	ButtonRemap::ButtonRemap(const RemapEntry * profile, size_t size) :
+		profile(profile), profileSize(size)
+	{
+		compile(ExtensionType::NoController);  // Empty tables until a controller is seen
+	}
+
+	void ButtonRemap::setProfile(const RemapEntry * p, size_t size) {
+		profile = p;
+		profileSize = size;
+		compile(compiledType);  // Rebuild in place for the current controller
+	}
+
+	void ButtonRemap::compile(ExtensionType type) {
+		const uint8_t FirstByte = 4;  // Button bytes are 4 and 5
+
+		for (uint8_t t = 0; t < 2; t++) {
+			// Virtual buttons driven by each bit of this byte
+			uint16_t bitOutputs[8] = { 0 };
+
+			for (size_t i = 0; i < profileSize; i++) {
+				const RemapEntry & entry = profile[i];
+				if (entry.type == type && entry.input.index == FirstByte + t && entry.input.position < 8) {
+					bitOutputs[entry.input.position] |= entry.output;
+				}
+			}
+
+			for (uint16_t value = 0; value < 256; value++) {
+				uint16_t out = 0x0000;
+				for (uint8_t bit = 0; bit < 8; bit++) {
+					if (!(value & (1 << bit))) {  // Inverted logic, '0' is pressed
+						out |= bitOutputs[bit];
+					}
+				}
+				table[t][value] = out;
+			}
+		}
+
+		compiledType = type;
+	}
+}
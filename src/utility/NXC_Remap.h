@@ -0,0 +1,106 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Remap_h
+#define NXC_Remap_h
+
+#include "Arduino.h"
+#include "internal/NXC_Identity.h"
+#include "internal/NXC_DataMaps.h"
+
+namespace NintendoExtensionCtrl {
+	// Button layout of the common 'virtual' gamepad, as bit masks
+	struct VirtualGamepad {
+		enum Button : uint16_t {
+			A = 0x0001,
+			B = 0x0002,
+			X = 0x0004,
+			Y = 0x0008,
+			L = 0x0010,
+			R = 0x0020,
+			ZL = 0x0040,
+			ZR = 0x0080,
+			Start = 0x0100,
+			Select = 0x0200,
+			Home = 0x0400,
+			DpadUp = 0x0800,
+			DpadDown = 0x1000,
+			DpadLeft = 0x2000,
+			DpadRight = 0x4000,
+			Extra = 0x8000,
+		};
+	};
+
+	// One line of a remap profile: a controller type, one of its button maps
+	// (button bytes 4 and 5 only), and the virtual button(s) it drives
+	struct RemapEntry {
+		ExtensionType type;
+		BitMap input;
+		uint16_t output;
+	};
+
+	// Gamepad layout for every supported controller type
+	extern const RemapEntry DefaultRemapProfile[];
+	extern const size_t DefaultRemapProfileSize;
+
+	// Compiles the profile lines for one controller type into two 256-entry
+	// tables, one per raw button byte. Each table entry holds the virtual buttons
+	// pressed for that byte value, so mapping a frame is two lookups and an OR.
+	// Tables are 1 KB of RAM, and are rebuilt in place when the profile or the
+	// connected controller type changes.
+	class ButtonRemap {
+	public:
+		ButtonRemap(const RemapEntry * profile = DefaultRemapProfile, size_t size = DefaultRemapProfileSize);
+
+		template<size_t size>
+		void setProfile(const RemapEntry(&profile)[size]) { setProfile(profile, size); }
+		void setProfile(const RemapEntry * profile, size_t size);
+
+		void compile(ExtensionType type);  // Build the tables for a controller type
+		ExtensionType getType() const { return compiledType; }
+
+		uint16_t map(uint8_t button0, uint8_t button1) const {
+			return table[0][button0] | table[1][button1];
+		}
+
+		uint16_t map(const uint8_t * controlData) const {
+			return map(controlData[4], controlData[5]);
+		}
+
+		template<class Controller>
+		uint16_t map(const Controller & controller) {
+			if (controller.getControllerType() != compiledType) {
+				compile(controller.getControllerType());  // Connected type changed
+			}
+			return map(controller.getControlData(4), controller.getControlData(5));
+		}
+
+	private:
+		const RemapEntry * profile;
+		size_t profileSize;
+
+		ExtensionType compiledType = ExtensionType::NoController;
+		uint16_t table[2][256];  // Virtual buttons pressed, per value of bytes 4 and 5
+	};
+}
+
+#endif
@@ -0,0 +1,141 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Scheduler.h"
+
+namespace NintendoExtensionCtrl {
+	uint32_t updateBusTime(uint8_t requestSize, uint32_t clockHz) {
+		if (clockHz == 0) clockHz = 100000;
+		const uint32_t pointerBits = 9 * 2 + 2;                   // Address + pointer
+		const uint32_t readBits = 9 * (requestSize + 1) + 2;      // Address + data
+		return ((pointerBits + readBits) * 1000000UL) / clockHz + I2C_ConversionDelay;
+	}
+
+	int8_t UpdateScheduler::add(ExtensionController & port, uint16_t rateHz, uint8_t priority) {
+		if (count >= capacity || rateHz == 0) {
+			return -1;
+		}
+
+		Slot & s = slots[count];
+		s.port = &port;
+		s.interval = 1000000UL / rateHz;
+		s.due = 0;
+		s.priority = priority;
+		s.started = false;
+		s.status = {};
+		return count++;
+	}
+
+	void UpdateScheduler::clear() {
+		count = 0;
+	}
+
+	uint8_t UpdateScheduler::run() {
+		return run(micros());
+	}
+
+	uint8_t UpdateScheduler::run(uint32_t now) {
+		uint32_t served = 0;  // Slots already looked at this run, one bit each
+		uint32_t spent = 0;
+		uint8_t updated = 0;
+
+		for (uint8_t i = 0; i < count; i++) {
+			if (!slots[i].started) {
+				slots[i].due = now;  // First update is due right away
+				slots[i].started = true;
+			}
+		}
+
+		while (true) {
+			// Pick the due port with the highest priority, then the earliest due time
+			int8_t next = -1;
+			for (uint8_t i = 0; i < count; i++) {
+				const Slot & s = slots[i];
+				if ((served & (1UL << i)) || (int32_t) (now - s.due) < 0) {
+					continue;
+				}
+				if (next < 0 || s.priority > slots[next].priority ||
+					(s.priority == slots[next].priority && (int32_t) (s.due - slots[next].due) < 0)) {
+					next = i;
+				}
+			}
+			if (next < 0) break;  // Nothing else is due
+
+			Slot & s = slots[next];
+			served |= 1UL << next;
+
+			// Always update at least one port, so a small budget can't stall everything
+			const uint32_t cost = busTime(next);
+			if (budget != 0 && updated > 0 && spent + cost > budget) {
+				break;  // Out of bus time, the rest wait for the next run
+			}
+
+			const uint32_t late = now - s.due;
+			if (late > s.status.maxLate) s.status.maxLate = late;
+
+			const uint32_t periods = late / s.interval;  // Whole periods gone without an update
+			if (periods > 0) {
+				s.status.missed += periods;
+				if (missCallback != nullptr) {
+					missCallback(next, periods > 0xFFFF ? 0xFFFF : periods);
+				}
+			}
+			s.due += (periods + 1) * s.interval;  // Skip the missed periods
+
+			s.status.updates++;
+			if (!s.port->update()) {
+				s.status.failures++;
+			}
+
+			spent += cost;
+			updated++;
+		}
+
+		return updated;
+	}
+
+	uint32_t UpdateScheduler::busTime(uint8_t slot) const {
+		return updateBusTime(slots[slot].port->getRequestSize(), clockHz);
+	}
+
+	uint8_t UpdateScheduler::busLoad() const {
+		uint32_t load = 0;
+		for (uint8_t i = 0; i < count; i++) {
+			load += (busTime(i) * 100) / slots[i].interval;
+		}
+		return load > 255 ? 255 : load;
+	}
+
+	uint32_t UpdateScheduler::missedDeadlines() const {
+		uint32_t total = 0;
+		for (uint8_t i = 0; i < count; i++) {
+			total += slots[i].status.missed;
+		}
+		return total;
+	}
+
+	void UpdateScheduler::resetStatus() {
+		for (uint8_t i = 0; i < count; i++) {
+			slots[i].status = {};
+		}
+	}
+}
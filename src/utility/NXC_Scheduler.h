@@ -0,0 +1,112 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Scheduler_h
+#define NXC_Scheduler_h
+
+#include "Arduino.h"
+#include "internal/ExtensionController.h"
+
+namespace NintendoExtensionCtrl {
+	// Bus time for one update() of 'requestSize' bytes at 'clockHz', in
+	// microseconds: the pointer write, the conversion delay, and the read.
+	// Each transaction is 9 bit times per byte (8 data + ACK, address
+	// included) plus start and stop.
+	uint32_t updateBusTime(uint8_t requestSize, uint32_t clockHz);
+
+	// Calls update() on ports at their own rates. Each port has a target rate
+	// and a priority. On every run(), the ports that are due are updated in
+	// priority order (earliest first within a priority), until the bus time
+	// budget for that run is spent. Ports that don't fit wait for the next run.
+	//
+	// A port misses a deadline when it isn't updated within one period of
+	// being due. Missed periods are skipped rather than caught up, so a busy
+	// bus doesn't cause a burst of updates later. Misses are counted per port
+	// and can be reported through a callback. Storage is provided by
+	// 'UpdateSchedulerTable' below.
+	class UpdateScheduler {
+	public:
+		typedef void (*MissCallback)(uint8_t slot, uint16_t periods);  // Slot number, periods missed
+
+		struct PortStatus {
+			uint32_t updates;   // Calls to update()
+			uint32_t failures;  // Of those, how many returned 'false'
+			uint32_t missed;    // Periods missed
+			uint32_t maxLate;   // Longest wait past the due time, in microseconds
+		};
+
+		// Returns the slot number, or -1 if the table is full or the rate is 0
+		int8_t add(ExtensionController & port, uint16_t rateHz, uint8_t priority = 0);  // Higher priority runs first
+		void clear();  // Remove all ports
+
+		void setClock(uint32_t hz) { clockHz = hz; }    // I2C clock, for bus time estimates
+		void setBudget(uint32_t us) { budget = us; }     // Bus time per run(), 0 for no limit
+		void onMiss(MissCallback fn) { missCallback = fn; }
+
+		uint8_t run();  // Returns the number of ports updated
+		uint8_t run(uint32_t now);  // 'now' from micros()
+
+		uint8_t size() const { return count; }
+		uint32_t busTime(uint8_t slot) const;   // Estimated bus time of one update, in microseconds
+		uint8_t busLoad() const;                // Bus time all ports need at their rates, in percent
+		const PortStatus & getStatus(uint8_t slot) const { return slots[slot].status; }
+		uint32_t missedDeadlines() const;       // Total for all ports
+		void resetStatus();
+
+		static const uint8_t MaxPorts = 32;
+
+	protected:
+		struct Slot {
+			ExtensionController * port;
+			uint32_t interval;  // Microseconds between updates
+			uint32_t due;       // micros() when the next update is due
+			uint8_t priority;
+			boolean started;    // 'due' is set after the first run
+			PortStatus status;
+		};
+
+		UpdateScheduler(Slot * table, uint8_t tableSize) :
+			slots(table), capacity(tableSize) {}
+
+	private:
+		Slot * const slots;
+		const uint8_t capacity;
+		uint8_t count = 0;
+
+		uint32_t clockHz = 100000;  // Wire's default
+		uint32_t budget = 0;
+		MissCallback missCallback = nullptr;
+	};
+
+	template<uint8_t Ports>
+	class UpdateSchedulerTable : public UpdateScheduler {
+	public:
+		static_assert(Ports <= MaxPorts, "The scheduler supports up to 32 ports");
+
+		UpdateSchedulerTable() : UpdateScheduler(table, Ports) {}
+
+	private:
+		Slot table[Ports];
+	};
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_SplitUpdate_h
+#define NXC_SplitUpdate_h
+
+#include "Arduino.h"
+#include "internal/ExtensionController.h"
+
+namespace NintendoExtensionCtrl {
+	// An update that runs in the background, for buses with non-blocking
+	// transfers like i2c_t3 on Teensy 3.x/LC: sendTransmission() and
+	// sendRequest() start a transfer, done() says when it's over, and
+	// getError() says how it went. The update is split into its phases
+	// (pointer write, conversion wait, read), and poll() moves it to the
+	// next one without waiting. Ports on different hardware buses then
+	// transfer at the same time:
+	//
+	//   BuildControllerClass<Nunchuk::Shared, i2c_t3> left(Wire), right(Wire1);
+	//   SplitUpdate<i2c_t3> updates[] = { left, right };
+	//
+	//   updateAll(updates);  // Returns the number of ports updated
+	//
+	// An update that isn't over within its timeout fails, so a stuck bus
+	// can't hold up the loop. The timeout is 10 ms by default, enough for a
+	// full read at 100 kHz, and setTimeout() changes it per port. i2c_t3's
+	// own timeout is off by default. After a timeout the bus may still be
+	// busy, and its resetBus() can free it.
+	//
+	// Ports on one bus still take turns, so give each port its own bus.
+	// Split updates always read from the bus, with no freshness check. A
+	// port that wasn't built with 'Bus' never starts.
+	template<class Bus>
+	class SplitUpdate {
+	public:
+		enum class State : uint8_t {
+			Idle,
+			PointerWrite,
+			ConversionWait,
+			Read,
+		};
+
+		static const unsigned long DefaultTimeout = 10000;  // us
+
+		SplitUpdate(ExtensionController & controller) :
+			port(controller), bus(controller.template getBusAs<Bus>()) {}
+
+		// Starts an update. 'false' if one is running, there's nothing to read,
+		// or the port is on another type of bus.
+		boolean start() {
+			if (state != State::Idle) return false;
+			if (bus == nullptr) {
+				result = false;
+				return false;
+			}
+			timedOut = false;
+
+			frame = port.startUpdate();
+			if (frame == nullptr) {
+				result = false;
+				return false;
+			}
+
+			bus->beginTransmission(I2C_Addr);
+			bus->write((uint8_t) 0x00);  // Control data pointer
+			bus->sendTransmission();
+			startTime = micros();
+			state = State::PointerWrite;
+			return true;
+		}
+
+		// Moves the update along. 'true' once it's finished (or if none is
+		// running), with the result in succeeded().
+		boolean poll() {
+			if (state != State::Idle && micros() - startTime >= timeout) {
+				timedOut = true;
+				return finish(0, state != State::PointerWrite);  // Give up on it
+			}
+
+			switch (state) {
+				case State::PointerWrite:
+					if (!bus->done()) return false;
+					if (bus->getError() != 0) return finish(0, false);  // Pointer write failed
+
+					waitStart = micros();
+					state = State::ConversionWait;
+					return false;
+
+				case State::ConversionWait:
+					if (micros() - waitStart < (unsigned long) I2C_ConversionDelay) return false;
+
+					bus->sendRequest(I2C_Addr, port.getRequestSize());
+					state = State::Read;
+					return false;
+
+				case State::Read: {
+					if (!bus->done()) return false;
+
+					uint8_t nBytesRecv = 0;
+					if (bus->getError() == 0) {
+						size_t available = bus->available();
+						if (available > port.getRequestSize()) available = port.getRequestSize();
+						nBytesRecv = bus->readBytes(frame, available);
+					}
+					return finish(nBytesRecv);
+				}
+
+				case State::Idle:
+				default:
+					return true;
+			}
+		}
+
+		boolean busy() const { return state != State::Idle; }
+		boolean succeeded() const { return result; }  // Result of the last update
+		boolean hasTimedOut() const { return timedOut; }  // Whether the last update ran out of time
+		State getState() const { return state; }
+
+		void setTimeout(unsigned long us) { timeout = us; }
+		unsigned long getTimeout() const { return timeout; }
+
+	private:
+		boolean finish(uint8_t nBytesRecv, boolean pointerSet = true) {
+			result = port.finishUpdate(nBytesRecv, pointerSet);
+			state = State::Idle;
+			return true;
+		}
+
+		ExtensionController & port;
+		Bus * const bus;  // nullptr if the port is on another type of bus
+
+		uint8_t * frame = nullptr;
+		unsigned long startTime = 0;
+		unsigned long waitStart = 0;
+		unsigned long timeout = DefaultTimeout;
+		State state = State::Idle;
+		boolean result = false;
+		boolean timedOut = false;
+	};
+
+	// Starts an update on every port, then polls them all until they're
+	// done or out of time. A nonzero 'timeout' (us) replaces every port's
+	// own, and 0 keeps what each was given with setTimeout(). Returns the
+	// number that succeeded.
+	template<class Bus, size_t N>
+	uint8_t updateAll(SplitUpdate<Bus> (&updates)[N], unsigned long timeout = 0) {
+		for (SplitUpdate<Bus> & u : updates) {
+			if (timeout != 0) u.setTimeout(timeout);
+			u.start();
+		}
+
+		boolean running;
+		do {
+			running = false;
+			for (SplitUpdate<Bus> & u : updates) {
+				if (!u.poll()) running = true;
+			}
+		} while (running);
+
+		uint8_t count = 0;
+		for (SplitUpdate<Bus> & u : updates) {
+			if (u.succeeded()) count++;
+		}
+		return count;
+	}
+}
+
+#endif
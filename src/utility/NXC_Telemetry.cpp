@@ -0,0 +1,140 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NXC_Telemetry.h"
+
+namespace NintendoExtensionCtrl {
+	namespace Telemetry {
+		uint8_t encode(const uint8_t * record, uint8_t size, uint8_t * frameOut) {
+			uint8_t codeIndex = 0;  // Where the current block's code byte goes
+			uint8_t outIndex = 1;
+			uint8_t code = 1;
+
+			for (uint8_t i = 0; i < size; i++) {
+				if (record[i] == 0x00) {
+					frameOut[codeIndex] = code;
+					codeIndex = outIndex++;
+					code = 1;
+				}
+				else {
+					frameOut[outIndex++] = record[i];
+					code++;
+					if (code == 0xFF) {  // Full block, no implied zero
+						frameOut[codeIndex] = code;
+						codeIndex = outIndex++;
+						code = 1;
+					}
+				}
+			}
+			frameOut[codeIndex] = code;
+			frameOut[outIndex++] = 0x00;  // Delimiter
+
+			return outIndex;
+		}
+
+		uint8_t decode(const uint8_t * frame, uint8_t size, uint8_t * recordOut) {
+			uint8_t inIndex = 0;
+			uint8_t outIndex = 0;
+
+			while (inIndex < size) {
+				const uint8_t code = frame[inIndex++];
+				if (code == 0x00 || inIndex + code - 1 > size) {
+					return 0;  // Stray delimiter or truncated block
+				}
+				for (uint8_t i = 1; i < code; i++) {
+					recordOut[outIndex++] = frame[inIndex++];
+				}
+				if (code != 0xFF && inIndex < size) {
+					recordOut[outIndex++] = 0x00;  // Implied zero between blocks
+				}
+			}
+
+			return outIndex;
+		}
+	}
+
+	TelemetryStream::TelemetryStream(Print & output, Channel * table, uint8_t tableSize)
+		: out(output), channels(table), numChannels(tableSize) {}
+
+	void TelemetryStream::reset() {
+		for (uint8_t i = 0; i < numChannels; i++) {
+			channels[i].size = 0;
+		}
+	}
+
+	boolean TelemetryStream::send(uint8_t port, ExtensionType type, const uint8_t * data, uint8_t size, uint32_t timestamp) {
+		if (port >= numChannels || size == 0 || size > Telemetry::MaxDataSize) {
+			return false;
+		}
+
+		Channel & ch = channels[port];
+		const boolean keyFrame = ch.size != size || ch.type != type
+			|| (keyFrameInterval != 0 && ch.sinceKeyFrame >= keyFrameInterval);
+
+		uint8_t record[Telemetry::MaxRecordSize];
+		record[0] = port | (keyFrame ? Telemetry::KeyFrame : 0x00) | (uint8_t) (ch.sequence++ << Telemetry::SequenceShift);
+		record[1] = (uint8_t) type;
+		record[2] = (uint8_t) timestamp;
+		record[3] = (uint8_t) (timestamp >> 8);
+		record[4] = (uint8_t) (timestamp >> 16);
+		record[5] = (uint8_t) (timestamp >> 24);
+		record[6] = size;
+
+		uint8_t length = Telemetry::HeaderSize;
+
+		if (keyFrame) {
+			memcpy(record + length, data, size);
+			length += size;
+			ch.type = type;
+			ch.size = size;
+			ch.sinceKeyFrame = 0;
+		}
+		else {
+			uint8_t * mask = record + length;
+			const uint8_t maskSize = (size + 7) / 8;
+			memset(mask, 0x00, maskSize);
+			length += maskSize;
+
+			for (uint8_t i = 0; i < size; i++) {
+				if (data[i] != ch.last[i]) {
+					mask[i >> 3] |= 1 << (i & 7);
+					record[length++] = data[i];
+				}
+			}
+			ch.sinceKeyFrame++;
+		}
+		memcpy(ch.last, data, size);
+
+		uint8_t frame[Telemetry::MaxFrameSize];
+		const uint8_t frameSize = Telemetry::encode(record, length, frame);
+		const size_t written = out.write(frame, frameSize);
+
+		records++;
+		bytes += written;
+
+		if (written != frameSize) {
+			ch.size = 0;  // Frame was cut short, resync with a key frame
+			return false;
+		}
+		return true;
+	}
+}
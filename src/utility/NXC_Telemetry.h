@@ -0,0 +1,126 @@
+/*
+*  Project     Nintendo Extension Controller Library
+*  @author     David Madison
+*  @link       github.com/dmadison/NintendoExtensionCtrl
+*  @license    LGPLv3 - Copyright (c) 2018 David Madison
+*
+*  This file is part of the Nintendo Extension Controller Library.
+*
+*  This program is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public License
+*  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NXC_Telemetry_h
+#define NXC_Telemetry_h
+
+#include "Arduino.h"
+#include "internal/NXC_Config.h"
+#include "internal/NXC_Identity.h"
+#include "internal/NXC_Comms.h"
+
+namespace NintendoExtensionCtrl {
+	// Binary telemetry format. Each record is COBS encoded and ends with a 0x00
+	// delimiter, so a reader can pick up the stream at any frame boundary.
+	//
+	// Record, before encoding:
+	//   [0]    Flags: port number (bits 0-3), key frame (bit 4), and a
+	//          per-port sequence number (bits 5-7) to catch dropped frames
+	//   [1]    ExtensionType
+	//   [2-5]  Timestamp in microseconds, little endian
+	//   [6]    Control data size, 1-21 bytes
+	//   Key frame:  every control data byte
+	//   Delta:      change mask, one bit per data byte (LSB first), followed
+	//               by only the bytes that changed since the port's last record
+	namespace Telemetry {
+		const uint8_t MaxPorts = 16;
+		const uint8_t PortMask = 0x0F;
+		const uint8_t KeyFrame = 0x10;
+		const uint8_t SequenceShift = 5;
+
+		const uint8_t HeaderSize = 7;
+		const uint8_t MaxDataSize = 21;
+		const uint8_t MaxMaskSize = (MaxDataSize + 7) / 8;
+		const uint8_t MaxRecordSize = HeaderSize + MaxMaskSize + MaxDataSize;
+		const uint8_t MaxFrameSize = MaxRecordSize + 2;  // COBS code byte + delimiter
+
+		// COBS, for records up to 254 bytes. 'encode' writes the trailing
+		// delimiter and returns the frame size. 'decode' takes a frame without
+		// its delimiter and returns the record size, or 0 if it's malformed.
+		uint8_t encode(const uint8_t * record, uint8_t size, uint8_t * frameOut);
+		uint8_t decode(const uint8_t * frame, uint8_t size, uint8_t * recordOut);
+	}
+
+	// Streams control data from one or more ports over any Print (a UART,
+	// USB serial, a file on the host). A port's first record, and any record
+	// after its controller type or request size changes, is a key frame. The
+	// rest only carry the bytes that changed. A key frame is also forced every
+	// 'keyFrameInterval' records, so a reader that drops a frame can resync.
+	// Storage is provided by 'TelemetryStreamTable' below.
+	class TelemetryStream {
+	public:
+		boolean send(uint8_t port, ExtensionType type, const uint8_t * data, uint8_t size, uint32_t timestamp);
+
+		template<class Controller>
+		boolean send(uint8_t port, const Controller & controller) {
+			uint8_t data[Telemetry::MaxDataSize];
+			const uint8_t size = controller.getRequestSize();
+		#if NXC_ENABLE_ISR_SAFE
+			controller.readFrame(data, size);  // All bytes from one frame
+		#else
+			for (uint8_t i = 0; i < size; i++) {
+				data[i] = controller.getControlData(i);
+			}
+		#endif
+			return send(port, controller.getControllerType(), data, size, micros());
+		}
+
+		void setKeyFrameInterval(uint8_t records) { keyFrameInterval = records; }  // 0 for only when needed
+		void reset();  // Next record on every port is a key frame
+
+		uint32_t recordsSent() const { return records; }
+		uint32_t bytesSent() const { return bytes; }
+
+	protected:
+		struct Channel {
+			ExtensionType type;
+			uint8_t size;  // 0 until the first key frame
+			uint8_t sinceKeyFrame;
+			uint8_t sequence;
+			uint8_t last[Telemetry::MaxDataSize];
+		};
+
+		TelemetryStream(Print & output, Channel * table, uint8_t tableSize);
+
+	private:
+		Print & out;
+		Channel * const channels;
+		const uint8_t numChannels;
+
+		uint8_t keyFrameInterval = 100;
+		uint32_t records = 0;
+		uint32_t bytes = 0;
+	};
+
+	template<uint8_t Ports>
+	class TelemetryStreamTable : public TelemetryStream {
+	public:
+		static_assert(Ports <= Telemetry::MaxPorts, "Telemetry supports up to 16 ports");
+
+		TelemetryStreamTable(Print & output = NXC_SERIAL_DEFAULT) : TelemetryStream(output, table, Ports) {}
+
+	private:
+		Channel table[Ports] = {};  // Zero size, so every port starts with a key frame
+	};
+}
+
+#endif